@@ -0,0 +1,30 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// 크기 등급별 수신 버퍼 풀 (리액터 스레드 전용, 잠금 없음)
+// 등급은 MIN_CLASS_SIZE부터 두 배씩 커지며, 반납된 버퍼는 같은 등급의 요청에 재사용합니다.
+// 가장 큰 등급보다 큰 요청은 풀을 거치지 않고 바로 할당/해제합니다.
+class BufferPool {
+public:
+    static const size_t MIN_CLASS_SIZE = 4096;
+
+    // maxPooledSize까지의 등급을 관리하고, 등급마다 최대 maxCachedPerClass개를 보관
+    BufferPool(size_t maxPooledSize, size_t maxCachedPerClass);
+    ~BufferPool();
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    // size 이상인 등급의 버퍼를 반환 (실제 크기는 classSize(size))
+    char* acquire(size_t size);
+    void release(char* buffer, size_t size);
+
+    static size_t classSize(size_t size);
+
+private:
+    size_t maxCachedPerClass;
+    std::vector<std::vector<char*>> freeLists;  // 등급별 반납된 버퍼
+
+    static size_t classIndex(size_t size);
+};
@@ -0,0 +1,86 @@
+#pragma once
+#include <string>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <utility>
+#include <sys/uio.h>
+#include "RingBuffer.hpp"
+#include "FrameDecoder.hpp"
+#include "Frame.hpp"
+#include "TimerWheel.hpp"
+#include "TokenBucket.hpp"
+#include "LatencyEstimator.hpp"
+#include "SharedMemoryChannel.hpp"
+
+// 클라이언트 연결 상태 (NetworkManager의 이벤트 루프가 소유)
+struct Connection {
+    int socket;
+    int playerId;
+    RingBuffer inbound;    // 아직 프레임으로 처리되지 않은 수신 데이터
+    FrameDecoder decoder;  // 부분 프레임 상태 (다음 수신에서 이어서 처리)
+
+    std::deque<FramePtr> outbound;  // 전송 대기 프레임 (소켓이 쓰기 가능할 때 한 번에 전송)
+    size_t outboundOffset;  // 첫 프레임에서 이미 전송한 바이트 수
+    size_t outboundBytes;   // 대기 중인 전체 바이트 수 (백엔드가 전송 중인 데이터 포함)
+    bool congested;         // 상위 워터마크를 넘어 게임 계층에 알린 상태
+    bool handshaken;        // connect 메시지를 받은 상태 (수락 제어의 대기 핸드셰이크 집계용)
+    bool closed;            // 닫힌 연결은 현재 이벤트 처리가 끝난 뒤 해제
+
+    bool unixSocket;        // AF_UNIX 리슨 소켓으로 들어온 로컬 연결 (zerocopy 미지원)
+    // 서버와 같은 uid의 프로세스라고 SO_PEERCRED로 확인한 AF_UNIX 연결 (room_* 관리 명령 허용)
+    // 로컬 봇도 같은 리스너를 쓰므로 unixSocket만으로는 운영 도구인지 알 수 없음
+    bool adminPeer;
+    // SOCK_SEQPACKET 연결의 최대 레코드 크기 (0이면 스트림)
+    // 레코드 하나가 길이 헤더를 포함한 프레임 하나이며, 한 번의 수신으로 통째로 읽어야 함
+    size_t maxRecordSize;
+    bool busyPoll;          // busy-poll 리스너로 들어온 저지연 연결 (리액터가 스핀 대기)
+    // 공유 메모리 전송으로 전환한 로컬 봇 연결 (이후 프레임은 소켓 대신 공유 링으로 주고받음)
+    std::unique_ptr<SharedMemoryChannel> sharedChannel;
+
+    // MSG_ZEROCOPY (epoll 백엔드): 커널이 완료를 알릴 때까지 보낸 프레임의 참조를 유지
+    bool zeroCopy;                    // SO_ZEROCOPY 사용 중 (커널이 복사로 처리하면 끔)
+    uint32_t zeroCopyNextId;          // 다음 zerocopy sendmsg 호출의 완료 알림 번호
+    std::deque<std::pair<uint32_t, FramePtr>> zeroCopyPending;
+
+    TokenBucket inputBucket;  // 입력 속도 제한
+    uint64_t droppedInputs;   // 속도 제한으로 버린 입력 수
+
+    LatencyEstimator latency;  // ping/pong으로 잰 RTT, 지터, 시계 오차
+
+    uint64_t lastActivityTick;         // 마지막으로 데이터를 받은 타이머 휠 틱
+    uint64_t lastPingTick;             // 마지막으로 ping을 보낸 타이머 휠 틱
+    TimerWheel::Timer heartbeatTimer;  // 하트비트 전송과 유휴 연결 정리
+
+    Connection(int clientSocket, int id, BufferPool* bufferPool = nullptr, uint32_t maxFrameSize = UINT32_MAX) :
+        socket(clientSocket),
+        playerId(id),
+        inbound(bufferPool),
+        decoder(maxFrameSize),
+        outboundOffset(0),
+        outboundBytes(0),
+        congested(false),
+        handshaken(false),
+        closed(false),
+        unixSocket(false),
+        adminPeer(false),
+        maxRecordSize(0),
+        busyPoll(false),
+        zeroCopy(false),
+        zeroCopyNextId(0),
+        droppedInputs(0),
+        lastActivityTick(0),
+        lastPingTick(0) {}
+
+    // 닫힌 연결을 새 소켓에 재사용할 수 있도록 처음 상태로 되돌림 (수신 버퍼와 대기 프레임은 반납)
+    // 하트비트 타이머는 호출 전에 취소되어 있어야 함
+    void reset(int clientSocket, int id);
+
+    // 대기 프레임을 iovec 배열로 채움 (반환값: iovec 개수)
+    // 두 번째 이후 프레임 중 stopAtSize 이상인 프레임을 만나면 그 앞에서 멈춤
+    int fillOutboundSpans(iovec* spans, int maxSpans, size_t stopAtSize = SIZE_MAX) const;
+    // 전송 완료된 바이트만큼 큐 앞에서 제거
+    void consumeOutbound(size_t length);
+    // zerocopy 완료 알림 번호 last까지의 프레임 참조 해제
+    void releaseZeroCopy(uint32_t last);
+};
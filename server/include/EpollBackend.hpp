@@ -0,0 +1,28 @@
+#pragma once
+#include "NetworkBackend.hpp"
+#include "EventLoop.hpp"
+
+// 엣지 트리거 epoll 기반 백엔드 (기본값)
+class EpollBackend : public NetworkBackend {
+private:
+    static const size_t MIN_READ_SPACE = 4096;
+    static const int MAX_SEND_SPANS = 64;
+
+    EventLoop& eventLoop;
+    Callbacks callbacks;
+    size_t zeroCopyThreshold;  // 이 크기 이상 프레임은 MSG_ZEROCOPY로 전송 (0이면 사용 안 함)
+
+    void acceptClients(int listenSocket);
+    void handleClientEvents(Connection& conn, uint32_t events);
+
+public:
+    EpollBackend(EventLoop& loop, const Callbacks& cb, size_t zeroCopyThreshold = 0);
+
+    void addListener(int listenSocket) override;
+    void addConnection(Connection& conn) override;
+    void removeConnection(Connection& conn) override;
+    void flush(Connection& conn) override;
+    int runOnce(int timeoutMs) override;
+    bool setBusyPoll(unsigned usecs, unsigned budget) override;
+    void reapZeroCopyCompletions(Connection& conn) override;
+};
@@ -5,6 +5,7 @@
 #include <map>
 #include <vector>
 #include <memory>
+#include <mutex>
 
 // Event 클래스 정의
 struct Event {
@@ -16,19 +17,24 @@ struct Event {
 };
 
 // EventBus 클래스 정의
+// 여러 네트워크 리액터 스레드가 발행하므로 이벤트 처리는 한 번에 하나씩 직렬화됩니다.
+// (핸들러 안에서 다시 발행할 수 있도록 재귀 뮤텍스 사용)
 class EventBus {
 private:
     // 이벤트 타입별 핸들러 맵
     std::map<std::string, std::vector<std::function<void(const Event&)>>> handlers;
+    std::recursive_mutex mutex;
     
 public:
     // 이벤트 핸들러 등록
     void subscribe(const std::string& eventType, std::function<void(const Event&)> handler) {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         handlers[eventType].push_back(handler);
     }
     
     // 이벤트 발행
     void publish(const Event& event) {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         if (handlers.find(event.name) != handlers.end()) {
             for (const auto& handler : handlers[event.name]) {
                 handler(event);
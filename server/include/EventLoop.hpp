@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// epoll 기반 이벤트 루프 (리액터)
+// 등록된 파일 디스크립터가 준비되면 해당 콜백을 호출합니다.
+// 다른 스레드는 post()로 작업을 넘기고 eventfd로 루프를 깨웁니다.
+class EventLoop {
+public:
+    using Handler = std::function<void(uint32_t events)>;
+    using Task = std::function<void()>;
+
+    EventLoop();
+    ~EventLoop();
+
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    // 파일 디스크립터 등록/변경/해제
+    void addFd(int fd, uint32_t events, Handler handler);
+    void modifyFd(int fd, uint32_t events);
+    void removeFd(int fd);
+
+    // 한 번 대기 후 준비된 이벤트를 처리 (timeoutMs < 0 이면 무한 대기)
+    // 반환값: 처리한 이벤트 수
+    int runOnce(int timeoutMs);
+
+    // epoll_wait가 잠들기 전에 NIC 수신 큐를 직접 폴링하도록 설정 (0이면 해제)
+    // 커널/헤더가 지원하지 않으면 false
+    bool setBusyPoll(unsigned usecs, unsigned budget);
+
+    // 다른 스레드에서 이 루프의 스레드로 작업 전달 (스레드 안전)
+    void post(Task task);
+
+    // 다른 이벤트 루프(io_uring 등)에서 감시할 수 있도록 epoll fd 노출
+    int getFd() const { return epollFd; }
+
+private:
+    static const int MAX_EVENTS = 256;
+
+    int epollFd;
+    int wakeupFd;
+    std::mutex taskMutex;
+    std::vector<Task> pendingTasks;
+    std::unordered_map<int, std::unique_ptr<Handler>> handlers;
+    // 콜백 실행 중 해제된 핸들러는 배치 처리가 끝난 뒤 파괴
+    std::vector<std::unique_ptr<Handler>> retiredHandlers;
+
+    void runPendingTasks();
+};
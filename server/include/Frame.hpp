@@ -0,0 +1,11 @@
+#pragma once
+#include <memory>
+#include <string>
+
+// 길이 헤더까지 인코딩이 끝난 불변 프레임
+// 브로드캐스트 시 한 번만 인코딩하고 모든 수신자의 송신 큐가 같은 버퍼를 참조합니다.
+using FramePtr = std::shared_ptr<const std::string>;
+
+inline FramePtr makeFrame(std::string bytes) {
+    return std::make_shared<const std::string>(std::move(bytes));
+}
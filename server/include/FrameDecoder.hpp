@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include "RingBuffer.hpp"
+#include "SharedRing.hpp"
+
+// 4바이트 빅엔디언 길이 접두사 프레임 디코더
+// 헤더를 읽은 뒤 본문이 덜 도착했으면 상태를 유지하고 다음 수신에서 이어서 처리합니다.
+// 길이가 최대 프레임 크기를 넘으면 버퍼를 확보하기 전에 실패 상태가 됩니다.
+class FrameDecoder {
+public:
+    // 프레임 본문 콜백. false를 반환하면 디코딩 중단 (예: 연결 종료)
+    using FrameHandler = std::function<bool(const char* data, size_t length)>;
+
+private:
+    enum class State { Header, Body, Failed };
+
+    State state;
+    uint32_t frameSize;
+    uint32_t maxFrameSize;
+    std::string scratch;  // 링 버퍼 경계에 걸친 프레임을 이어 붙이는 용도
+
+    template <typename Buffer>
+    size_t decodeFrames(Buffer& buffer, const FrameHandler& onFrame);
+
+public:
+    explicit FrameDecoder(uint32_t maxSize = UINT32_MAX) :
+        state(State::Header), frameSize(0), maxFrameSize(maxSize) {}
+
+    // 버퍼에 있는 완성된 프레임을 모두 처리하고 처리한 프레임 수를 반환
+    size_t decode(RingBuffer& buffer, const FrameHandler& onFrame);
+    // 공유 메모리 링에서 바로 디코딩 (링 경계에 걸친 프레임만 복사)
+    size_t decode(SharedRing& buffer, const FrameHandler& onFrame);
+
+    // 최대 크기를 넘는 프레임 헤더를 받은 상태 (연결을 닫아야 함)
+    bool failed() const { return state == State::Failed; }
+    uint32_t pendingFrameSize() const { return frameSize; }
+    // 헤더를 이미 소비하고 본문을 기다리는 중이면 그 크기 (아니면 0, 무중단 재시작 때 헤더를 되살리는 데 사용)
+    uint32_t pendingBodySize() const { return state == State::Body ? frameSize : 0; }
+
+    // 처음 상태로 되돌림 (최대 프레임 크기는 유지)
+    void reset() {
+        state = State::Header;
+        frameSize = 0;
+        scratch.clear();
+    }
+};
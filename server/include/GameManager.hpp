@@ -1,6 +1,9 @@
 #pragma once
 #include <vector>
 #include <map>
+#include <random>
+#include <set>
+#include <string>
 #include "PlayerInfo.hpp"
 #include "Event.hpp"
 #include "SimpleMessagePack.hpp"
@@ -14,6 +17,27 @@ private:
     map<int, PlayerInfo> players;
     bool gameStarted;
     EventBus& eventBus;
+    set<int> congestedPlayers;  // 송신 큐가 상위 워터마크를 넘은 플레이어
+    set<int> changedPlayers;    // 현재 처리 단계에서 상태가 바뀐 플레이어
+    set<int> suspendedPlayers;  // 연결이 끊겨 재연결을 기다리는 플레이어 (상태는 보관)
+    set<int> ackedPlayers;      // 상태 대신 처리한 입력 번호만 알리면 되는 플레이어
+
+    // 클라이언트 예측용: 입력마다 붙는 클라이언트 시퀀스 번호 중 마지막으로 처리한 번호
+    // (상태를 보낼 때 함께 실어 클라이언트가 아직 반영되지 않은 입력만 다시 적용하게 함)
+    map<int, int64_t> lastInputSeq;
+
+    // 방: connect에서 고른 방 이름 (방 단위로 다른 서버 프로세스로 옮김)
+    map<int, string> playerRooms;
+    set<string> pausedRooms;  // 스냅샷을 떠서 옮기는 중인 방 (입력을 반영하지 않음)
+    std::mt19937 seedGenerator;  // 플레이어별 조각 난수 생성기의 시드
+
+    // 재연결한 클라이언트에게 마지막으로 받은 상태 이후의 변경분만 보내기 위한 전송 기록
+    struct StateHistory {
+        int64_t seq = 0;                  // 마지막으로 전송한 상태 번호
+        vector<vector<int>> board;        // 마지막으로 전송한 보드
+        vector<vector<int64_t>> cellSeq;  // 칸마다 마지막으로 바뀐 상태 번호
+    };
+    map<int, StateHistory> stateHistory;
 
 public:
     GameManager(EventBus& bus);
@@ -21,18 +45,33 @@ public:
     void addPlayer(int playerId, int socket);
     void removePlayer(int playerId);
     void handleNewPiece(int playerId);
-    void handleMove(int playerId, int direction);
-    void handleRotate(int playerId);
+    // 조각만 움직였으면 true (블록 고정/새 조각처럼 클라이언트가 예측할 수 없는 변화는 false)
+    bool handleMove(int playerId, int direction);
+    bool handleRotate(int playerId);
     void handleHardDrop(int playerId);
-    void handleMoveDown(int playerId);
+    bool handleMoveDown(int playerId);
     bool isValidMove(const vector<vector<int>>& board, const MessageData& piece, const vector<int>& pos);
     void freezePiece(int playerId);
     void checkLines(int playerId);
     MessageData getGameState() const;
     PlayerInfo& getPlayer(int playerId);
     const map<int, PlayerInfo>& getPlayers() const { return players; }
+    // 플레이어별 최종 점수를 파일 끝에 덧붙임 (한 줄에 "시각<TAB>플레이어 ID<TAB>점수<TAB>방")
+    void saveResults(const string& path) const;
 
 private:
-    pair<MessageData, int> generateNewPiece();
+    pair<MessageData, int> generateNewPiece(PlayerInfo& player);
+    void handleInput(const MessageData& input);
+    void markStateChanged(int playerId);
+    void flushStateChanges();
+    void publishPlayerState(int playerId);
+    void recordState(int playerId, const PlayerInfo& player);
+    void publishResumeState(int playerId, int64_t lastStateSeq);
     MessageData rotatePiece(const MessageData& piece);
+    MessageData exportPlayer(int playerId);
+    void importPlayer(int playerId, const MessageData& state);
+    void exportRoom(const MessageData& request);
+    void restoreRoom(const MessageData& data);
+    MessageData exportGame();
+    void restoreGame(const MessageData& snapshot);
 }; 
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Event.hpp"
+#include "NetworkManager.hpp"
+#include "ProcessLink.hpp"
+#include "ServerConfig.hpp"
+
+// 게이트웨이 모드: 클라이언트 연결, 프레임 디코딩/검증은 이 프로세스가 맡고
+// 게임 입력 이벤트는 플레이어를 배정한 시뮬레이션 프로세스로 넘깁니다.
+// 시뮬레이션이 돌려보낸 프레임은 이미 인코딩이 끝났으므로 그대로 연결의 송신 큐에 넣습니다.
+class GatewayBridge {
+public:
+    // 설정의 시뮬레이션 소켓에 모두 연결. 하나라도 실패하면 std::runtime_error
+    GatewayBridge(const ServerConfig& config, EventBus& bus, NetworkManager& network);
+    ~GatewayBridge();
+
+    GatewayBridge(const GatewayBridge&) = delete;
+    GatewayBridge& operator=(const GatewayBridge&) = delete;
+
+private:
+    struct Simulation {
+        std::string path;
+        std::unique_ptr<ProcessLink> link;
+        bool lost = false;  // 링크가 끊겨 새 플레이어를 배정하지 않음 (assignmentMutex로 보호)
+    };
+
+    EventBus& eventBus;
+    NetworkManager& networkManager;
+    std::vector<Simulation> simulations;
+
+    // 플레이어 → 시뮬레이션 배정 (게임 이벤트 처리와 시뮬레이션 수신 스레드가 함께 사용)
+    std::mutex assignmentMutex;
+    std::unordered_map<int, size_t> playerSimulations;
+    bool closing = false;  // 해제 중에는 링크가 끊겨도 플레이어를 정리하지 않음
+
+    void setupEventHandlers();
+    void forward(const std::string& name, const MessageData& data);
+    void handleRecord(size_t simulation, const char* data, size_t length);
+    void handleLinkClosed(size_t simulation);
+};
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "SimpleMessagePack.hpp"
+
+// 무중단 재시작: 새 바이너리로 띄운 후임 프로세스가 실행 중인 프로세스의 --handoff 소켓에 접속하면
+// 이전 프로세스가 리스너와 클라이언트 소켓(SCM_RIGHTS), 세션과 게임 상태를 넘겨줍니다.
+// 소켓 자체를 넘기므로 클라이언트는 연결을 끊지 않고, 넘기는 동안 들어온 데이터는 커널 버퍼에 쌓여 있습니다.
+//
+//   이전 → 후임: [상태 길이 4바이트 빅엔디언][MessageData 직렬화][fd 개수 4바이트 빅엔디언]
+//                이어서 fd를 MAX_FDS_PER_MESSAGE개씩 1바이트 메시지에 실어 보냄 (상태의 fd 값은 이 목록의 순번)
+//   후임 → 이전: 상태를 모두 복원하면 ACK 1바이트
+//   이전 → 후임: ACK를 받고 넘겨주기를 확정하면 ACK 1바이트 (보낸 뒤로는 서비스를 재개하지 않음)
+// 이전 프로세스는 ACK를 받기 전까지 아무것도 닫지 않으며, 연결이 끊기거나 제한 시간이 지나면 그대로 서비스를 재개합니다.
+// 후임 프로세스는 확정 ACK를 받기 전까지 소켓에 아무것도 쓰지 않고, 받지 못하면 넘겨받은 fd를 닫고 실패로 종료해
+// 두 프로세스가 같은 소켓을 동시에 서비스하지 않습니다.
+class HotRestart {
+public:
+    static const char ACK = 'K';
+    static const int ACK_TIMEOUT_MS = 10000;
+
+    // 블로킹 소켓에서 상태와 fd를 주고받음 (실패하면 false, 받다가 실패하면 이미 받은 fd는 닫음)
+    static bool send(int socket, const MessageData& state, const std::vector<int>& fds);
+    static bool receive(int socket, MessageData& state, std::vector<int>& fds);
+
+    static bool sendAck(int socket);
+    // 상대가 ACK를 보낼 때까지 기다림 (제한 시간이 지나거나 연결이 끊기면 false)
+    static bool waitAck(int socket, int timeoutMs);
+
+private:
+    static constexpr size_t MAX_FDS_PER_MESSAGE = 250;  // 커널 한도(SCM_MAX_FD 253) 이하
+    static const uint32_t MAX_STATE_SIZE = 256 * 1024 * 1024;
+};
@@ -0,0 +1,114 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include "NetworkBackend.hpp"
+#include "EventLoop.hpp"
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+struct io_uring_buf_ring;
+
+// io_uring 기반 백엔드
+// - 멀티샷 accept: 리슨 소켓당 SQE 하나로 모든 연결을 수락
+// - 멀티샷 recv + 제공 버퍼 링: 연결당 SQE 하나로 계속 수신
+// - send는 SQE로 쌓아 두었다가 대기 호출 시 한 번에 제출
+// - SEQPACKET 연결은 제공 버퍼(4KB)에서 레코드가 잘리지 않도록 연결의 링 버퍼로 직접 recvmsg
+// 보조 fd(타이머 등)는 EventLoop의 epoll fd를 멀티샷 poll로 감시해 함께 처리합니다.
+class IoUringBackend : public NetworkBackend {
+private:
+    enum Operation : uint64_t { OpAccept = 1, OpRecv, OpSend, OpPoll, OpCancel, OpListenPoll, OpRecvRecord };
+
+    static const unsigned RING_ENTRIES = 4096;
+    static const unsigned BUFFER_COUNT = 1024;   // 2의 거듭제곱
+    static const unsigned BUFFER_SIZE = 4096;
+    static const uint16_t BUFFER_GROUP = 0;
+    static const size_t MAX_SEND_SPANS = 64;
+
+    // 연결별 비동기 작업 상태
+    struct Slot {
+        Connection* conn;
+        uint32_t generation;       // fd 재사용 시 이전 연결의 완료 이벤트를 구분
+        bool sendPending;
+        bool zeroCopy;                      // 진행 중인 전송이 SENDMSG_ZC인지
+        std::vector<FramePtr> inFlight;     // 커널이 전송 중인 프레임 (완료 전까지 참조 유지)
+        std::vector<iovec> inFlightSpans;
+        size_t firstSpan;                   // 부분 전송 후 남은 첫 iovec 위치
+        msghdr message;
+
+        // SEQPACKET 수신 (연결의 링 버퍼 빈 공간을 가리킴)
+        msghdr recvMessage;
+        iovec recvSpans[2];
+        size_t recvRequested;
+    };
+
+    EventLoop& eventLoop;
+    Callbacks callbacks;
+    size_t zeroCopyThreshold;  // 이 크기 이상 프레임이 있으면 SENDMSG_ZC로 전송 (0이면 사용 안 함)
+
+    // 링 매핑
+    int ringFd;
+    void* sqRingPtr;
+    size_t sqRingSize;
+    void* cqRingPtr;
+    size_t cqRingSize;
+    io_uring_sqe* sqes;
+    size_t sqesSize;
+    unsigned* sqHead;
+    unsigned* sqTail;
+    unsigned* sqMask;
+    unsigned* sqArray;
+    unsigned sqEntries;
+    unsigned sqLocalTail;    // 아직 제출하지 않은 SQE까지 포함한 tail
+    unsigned* cqHead;
+    unsigned* cqTail;
+    unsigned* cqMask;
+    io_uring_cqe* cqes;
+
+    // 제공 버퍼 링
+    io_uring_buf_ring* bufferRing;
+    size_t bufferRingSize;
+    char* bufferBase;
+    uint16_t bufferRingTail;
+
+    uint32_t nextGeneration;
+    std::unordered_map<int, Slot> slots;                    // 소켓을 키로 하는 연결 상태
+    std::unordered_map<uint64_t, Slot> orphanedSends;       // 연결이 닫힌 뒤 완료를 기다리는 전송
+    // SENDMSG_ZC 전송 결과 뒤 버퍼 해제 알림(F_NOTIF)을 기다리는 프레임 (제출 순서대로)
+    std::unordered_map<uint64_t, std::deque<std::vector<FramePtr>>> zeroCopyHeld;
+
+    static uint64_t makeUserData(Operation op, uint32_t generation, int fd);
+
+    io_uring_sqe* getSqe();
+    int submit(unsigned waitCount, int timeoutMs);
+    void setupBufferRing();
+    void recycleBuffer(uint16_t bufferId);
+
+    void submitAccept(int listenSocket);
+    void submitRecv(int fd, uint32_t generation);
+    void submitRecordRecv(Slot& slot);
+    void submitSend(int fd, Slot& slot);
+    void completeSend(Slot& slot, int result);
+    void releaseZeroCopy(const io_uring_cqe& cqe);
+    void submitPoll();
+    void submitListenPoll(int listenSocket);
+    void handleCompletion(const io_uring_cqe& cqe);
+
+public:
+    IoUringBackend(EventLoop& loop, const Callbacks& cb, size_t zeroCopyThreshold = 0);
+    ~IoUringBackend() override;
+
+    IoUringBackend(const IoUringBackend&) = delete;
+    IoUringBackend& operator=(const IoUringBackend&) = delete;
+
+    void addListener(int listenSocket) override;
+    void addConnection(Connection& conn) override;
+    void removeConnection(Connection& conn) override;
+    void flush(Connection& conn) override;
+    int runOnce(int timeoutMs) override;
+    bool setBusyPoll(unsigned usecs, unsigned budget) override;
+};
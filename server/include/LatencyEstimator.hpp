@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+#include <cstdlib>
+
+// 연결별 왕복 지연(RTT), 지터, 클라이언트 시계 오차 추정
+// 서버 ping에 대한 pong 하나가 표본 하나이며 모든 값의 단위는 마이크로초입니다.
+// - RTT: TCP(RFC 6298)와 같은 1/8 지수 평활
+// - 지터: 연속한 RTT 표본 차이의 1/16 평활 (RFC 3550)
+// - 시계 오차: 최근 표본 중 RTT가 가장 작은 표본의 값 (지연이 짧을수록 비대칭 오차가 작음, NTP 방식)
+struct LatencyEstimator {
+    static const int OFFSET_WINDOW = 8;
+
+    int64_t smoothedRttUs = 0;
+    int64_t minRttUs = 0;
+    int64_t lastRttUs = 0;
+    int64_t jitterUs = 0;
+    int64_t clockOffsetUs = 0;  // 클라이언트 시계 - 서버 시계
+    uint64_t samples = 0;
+    uint64_t clockSamples = 0;  // 클라이언트 시각이 포함된 표본 수 (0이면 시계 오차를 모름)
+
+    // 응답을 기다리는 ping (보낸 시각이 0이면 없음)
+    int64_t pendingServerTimeUs = 0;  // ping에 실어 보낸 서버 시각 (CLOCK_REALTIME)
+    int64_t pendingSentNs = 0;        // 보낸 시각 (CLOCK_MONOTONIC, RTT 계산용)
+
+    void addSample(int64_t rttUs) {
+        if (samples == 0) {
+            smoothedRttUs = rttUs;
+            minRttUs = rttUs;
+            jitterUs = 0;
+        } else {
+            smoothedRttUs += (rttUs - smoothedRttUs) / 8;
+            jitterUs += (std::llabs(rttUs - lastRttUs) - jitterUs) / 16;
+            if (rttUs < minRttUs) {
+                minRttUs = rttUs;
+            }
+        }
+        lastRttUs = rttUs;
+        samples++;
+    }
+
+    // serverTimeUs: ping에 실어 보낸 서버 시각, clientTimeUs: 클라이언트가 pong에 찍은 시각
+    void addClockSample(int64_t rttUs, int64_t serverTimeUs, int64_t clientTimeUs) {
+        // 왕복의 절반이 지났을 때 클라이언트 시각을 찍었다고 가정
+        Entry& entry = window[clockSamples % OFFSET_WINDOW];
+        entry.rttUs = rttUs;
+        entry.offsetUs = clientTimeUs - (serverTimeUs + rttUs / 2);
+        clockSamples++;
+
+        const Entry* best = &window[0];
+        int filled = clockSamples < OFFSET_WINDOW ? static_cast<int>(clockSamples) : OFFSET_WINDOW;
+        for (int i = 1; i < filled; ++i) {
+            if (window[i].rttUs < best->rttUs) {
+                best = &window[i];
+            }
+        }
+        clockOffsetUs = best->offsetUs;
+    }
+
+private:
+    struct Entry {
+        int64_t rttUs;
+        int64_t offsetUs;
+    };
+    Entry window[OFFSET_WINDOW] = {};
+};
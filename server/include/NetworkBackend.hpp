@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include "Connection.hpp"
+
+// 소켓 I/O 백엔드 인터페이스
+// NetworkManager는 연결/프레임 처리만 담당하고, 실제 accept/recv/send는 백엔드가 수행합니다.
+class NetworkBackend {
+public:
+    struct Callbacks {
+        std::function<void(int listenSocket, int clientSocket)> onAccept;
+        std::function<void(int listenSocket, int error)> onAcceptError;  // accept 실패 (errno 값)
+        std::function<void(Connection& conn)> onReadable;  // conn.inbound에 새 데이터가 쌓임
+        std::function<void(Connection& conn)> onClosed;  // 상대방 종료 또는 소켓 오류
+        std::function<void(Connection& conn)> onSent;    // 송신 큐 일부가 전송됨 (워터마크 확인용)
+    };
+
+    virtual ~NetworkBackend() = default;
+
+    virtual void addListener(int listenSocket) = 0;
+    virtual void addConnection(Connection& conn) = 0;
+    // 소켓을 닫기 전에 호출 (진행 중인 비동기 작업 정리)
+    virtual void removeConnection(Connection& conn) = 0;
+    // conn.outbound에 쌓인 프레임 전송 시작
+    virtual void flush(Connection& conn) = 0;
+    // 한 번 대기 후 완료/준비된 이벤트를 처리 (timeoutMs < 0 이면 무한 대기)
+    // 반환값: 처리한 이벤트/완료 수 (busy-poll 스핀이 유휴 상태를 판단하는 데 사용)
+    virtual int runOnce(int timeoutMs) = 0;
+    // 대기 호출에서 커널이 잠들기 전에 NIC 큐를 폴링하도록 설정 (usecs가 0이면 해제)
+    // 지원하지 않으면 false (사용자 공간 스핀만 동작)
+    virtual bool setBusyPoll(unsigned usecs, unsigned budget) = 0;
+    // 소켓의 에러 큐에서 MSG_ZEROCOPY 완료 알림을 읽어 conn.zeroCopyPending을 정리
+    // (epoll에서 뺀 뒤에도 닫기 전까지 호출 가능, zerocopy를 conn 밖에서 관리하는 백엔드는 아무것도 안 함)
+    virtual void reapZeroCopyCompletions(Connection&) {}
+};
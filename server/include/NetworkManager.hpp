@@ -1,23 +1,193 @@
 #pragma once
 #include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "BufferPool.hpp"
 #include "Event.hpp"
+#include "EventLoop.hpp"
+#include "Connection.hpp"
+#include "Frame.hpp"
+#include "NetworkBackend.hpp"
+#include "PlayerIdAllocator.hpp"
+#include "RestartHandoff.hpp"
+#include "RoomRouter.hpp"
+#include "ServerConfig.hpp"
+#include "SessionRegistry.hpp"
 #include "SimpleMessagePack.hpp"
+#include "TimerWheel.hpp"
+#include "UdpInputChannel.hpp"
 
 class NetworkManager {
 private:
-    int listenSocket;
+    static const int TIMER_TICK_MS = 100;
+    static const size_t TIMER_SLOTS = 1024;  // 틱 100ms 기준 약 100초에 한 바퀴
+    // 이보다 큰 수신 버퍼는 풀에 보관하지 않음 (SEQPACKET 연결이 최대 프레임을 통째로 받는 크기 포함)
+    static const size_t POOLED_BUFFER_MAX = 128 * 1024;
+    static const size_t POOLED_BUFFERS_PER_CLASS = 256;
+    static const int DRAIN_CHECK_MS = 500;      // 드레인 중 남은 게임 확인 주기
+    static const int SHUTDOWN_FLUSH_MS = 2000;  // 종료 직전 송신 큐를 비우고 클라이언트가 닫기를 기다리는 최대 시간
+    // 샤드마다 미리 만들어 두는 연결 슬롯 수와, 연결이 몰렸다 빠진 뒤 재사용을 위해 남겨 두는 최대 슬롯 수
+    static const size_t PREALLOCATED_CONNECTIONS = 256;
+    static const size_t MAX_FREE_CONNECTIONS = 4096;
+    static const int ZEROCOPY_LINGER_MS = 5000;  // 닫은 연결의 zerocopy 완료 알림을 기다리는 최대 시간
+
+    // 다른 샤드에서 넘어온 송신 프레임 (socket < 0 이면 샤드의 모든 연결에 전송)
+    struct PendingFrame {
+        int playerId;
+        int socket;
+        FramePtr frame;
+    };
+
+    // 리액터 샤드: 자신의 리슨 소켓(SO_REUSEPORT), 이벤트 루프, 백엔드와 연결을 소유하고
+    // 전용 스레드에서 실행됩니다. 연결은 수락한 샤드의 스레드에서만 접근합니다.
+    struct Shard {
+        int index;
+        int listenSocket = -1;
+        int busyPollListenSocket = -1;  // busy-poll 전용 리스너 (설정한 경우에만)
+        EventLoop eventLoop;
+        TimerWheel timers{eventLoop, TIMER_TICK_MS, TIMER_SLOTS};
+        BufferPool bufferPool{POOLED_BUFFER_MAX, POOLED_BUFFERS_PER_CLASS};  // 연결보다 오래 살아야 함
+        std::unique_ptr<NetworkBackend> backend;
+        std::unordered_map<int, std::unique_ptr<Connection>> connections;  // 소켓을 키로 하는 연결 목록
+        std::vector<std::unique_ptr<Connection>> closedConnections;         // 루프 반복이 끝나면 슬롯으로 반납
+        std::vector<std::unique_ptr<Connection>> freeConnections;           // 수락 시 꺼내 쓰는 빈 연결 슬롯
+        // 닫았지만 커널이 MSG_ZEROCOPY로 보낸 프레임을 아직 읽고 있는 연결 (완료 알림이 오면 소켓을 닫고 해제)
+        std::vector<std::pair<int64_t, std::unique_ptr<Connection>>> zeroCopyClosing;  // (마감 시각 ms, 연결)
+        TimerWheel::Timer zeroCopyTimer;
+        PlayerIdAllocator::Block idBlock;
+        std::thread thread;
+
+        std::mutex inboxMutex;
+        std::vector<PendingFrame> inbox;
+
+        // fd 고갈(EMFILE) 시 잠시 반납해 대기 중인 연결을 받아 거절하기 위한 예비 fd
+        int spareFd = -1;
+
+        // 리액터 스레드의 CPU 사용률 (수락 시점에 주기적으로 갱신)
+        double cpuLoad = 0.0;
+        int64_t lastLoadSampleNs = 0;
+        int64_t lastCpuTimeNs = 0;
+
+        // 이 샤드의 busy-poll 연결 수 (0보다 크면 리액터가 잠들기 전에 스핀)
+        int busyPollConnections = 0;
+
+        // 공유 메모리 링으로 전환한 연결 (스핀 중에는 도어벨 없이 직접 확인)
+        std::vector<Connection*> sharedConnections;
+
+        TimerWheel::Timer shutdownTimer;  // 종료 직전 송신 큐가 비었는지 확인
+
+        ~Shard();
+    };
+
+    // 플레이어가 어느 샤드의 어떤 소켓에 연결되어 있는지
+    struct PlayerRoute {
+        Shard* shard;
+        int socket;
+    };
+
     EventBus& eventBus;
+    ServerConfig config;
+    std::vector<std::unique_ptr<Shard>> shards;
+    int unixListenSocket = -1;  // 모든 샤드가 함께 수락하는 AF_UNIX 리슨 소켓
+    std::atomic<bool> running;
+    PlayerIdAllocator playerIds;
+    RestartHandoff handoff;  // 무중단 재시작 (이전 프로세스에서 넘겨받거나 후임 프로세스에 넘김)
+
+    // 플레이어 ID로 연결 위치 조회. 연결 종료/resume이 서로 다른 샤드에서 동시에 일어나도
+    // 경로와 재연결 세션이 한 번에 바뀌도록 세션 갱신도 이 뮤텍스를 잡은 채로 함
+    std::mutex routeMutex;
+    std::unordered_map<int, PlayerRoute> playerRoutes;
+
+    // 수락 제어용 전체 카운터 (모든 샤드에서 갱신)
+    std::atomic<int> connectionCount{0};
+    std::atomic<int> pendingHandshakes{0};     // connect 메시지를 아직 보내지 않은 연결
+    std::atomic<int> congestedConnections{0};  // 송신 큐가 상위 워터마크를 넘은 연결
+
+    std::atomic<uint64_t> droppedInputs{0};  // 입력 속도 제한으로 버린 전체 입력 수
+
+    // 선택적 UDP 입력 채널 (첫 번째 리액터에서 수신, 샤드보다 먼저 해제)
+    std::unique_ptr<UdpInputChannel> udpChannel;
+
+    // 재연결 세션(만료 확인은 첫 번째 샤드의 타이머 휠)과 방 라우팅/이동. 샤드보다 먼저 해제
+    std::unique_ptr<SessionRegistry> sessions;
+    std::unique_ptr<RoomRouter> roomRouter;
+
+    MessageData gameSnapshot;  // 무중단 재시작 시 game_snapshot_request에 대한 게임 계층의 응답
+
+    // 종료 드레인: 새 연결을 거절하고 진행 중인 게임이 끝나거나 마감 시각이 지나면
+    // 종료 안내를 보내고 송신 큐를 비운 뒤 리액터를 멈춤 (진행 상황은 첫 번째 샤드에서 확인)
+    std::atomic<bool> draining{false};
+    std::atomic<bool> shuttingDown{false};  // 송신 큐를 비우는 중 (이후 입력은 무시)
+    int64_t drainDeadlineMs = 0;
+    int64_t shutdownDeadlineMs = 0;
+    std::atomic<int> flushedShards{0};
+    TimerWheel::Timer drainTimer;
+    std::unordered_set<int> finishedPlayers;  // game_over가 난 플레이어 (routeMutex로 보호)
 
-    void handleClientMessages(int playerId, int clientSocket);
+    int openListenSocket(int port, bool reusePort);
+    void configureBusyPoll(int listenSocket);
+    void updateBusyPoll(Shard& shard, int delta);
+    int openUnixListenSocket();
+    void runShard(Shard& shard);
+    void acceptClient(Shard& shard, int listenSocket, int clientSocket);
+    int allocatePlayerId(Shard& shard);
+    std::unique_ptr<Connection> acquireConnection(Shard& shard, int socket, int playerId);
+    void recycleConnections(Shard& shard);
+    void closeZeroCopyConnections(Shard& shard);
+    void startHeartbeat(Shard& shard, Connection& conn);
+    void completeTakeover();
+    void adoptConnection(Shard& shard, const MessageData& state, int socket);
+    void openHandoffListener();
+    bool handOff();
+    int activeGames();
+    void checkDrain();
+    void flushForShutdown(Shard& shard);
+    const char* checkAdmission(Shard& shard);
+    double sampleReactorLoad(Shard& shard);
+    void rejectClient(int clientSocket, const char* reason);
+    void handleAcceptError(Shard& shard, int listenSocket, int error);
+    void checkHeartbeat(Shard& shard, Connection& conn);
+    void sendPing(Shard& shard, Connection& conn);
+    void handlePong(Connection& conn, MessageData& msg);
+    void resumeSession(Shard& shard, Connection& conn, const MessageData& msg);
+    void handleClientMessages(Shard& shard, Connection& conn);
+    bool handleFrame(Shard& shard, Connection& conn, const char* data, size_t length, int64_t nowNs);
+    void attachSharedMemory(Shard& shard, Connection& conn);
+    size_t pollSharedChannel(Shard& shard, Connection& conn, bool arm);
+    size_t pollSharedChannels(Shard& shard, bool arm);
+    void flushShared(Connection& conn);
+    void dispatchMessage(Shard& shard, Connection& conn, const char* messageData, size_t length, int64_t nowNs);
+    bool takeInputToken(Connection& conn, int64_t nowNs);
+    void pushFrame(Shard& shard, PendingFrame pending);
+    void drainInbox(Shard& shard);
+    void deliverPending(Shard& shard, const PendingFrame& pending);
+    void enqueueFrame(Shard& shard, Connection& conn, const FramePtr& frame);
+    void updateBackpressure(Connection& conn);
+    void closeConnection(Shard& shard, Connection& conn);
     void setupEventHandlers();
 
     std::string packMessage(const MessageData& message);
-    MessageData unpackMessage(const std::string& data);
+    MessageData unpackMessage(const char* data, size_t length);
 
 public:
-    NetworkManager(int port, EventBus& bus);
+    NetworkManager(const ServerConfig& config, EventBus& bus);
     ~NetworkManager();
-    void acceptClient();
+    void run();
+    void stop();
+    // 스레드 안전. 이미 드레인 중이면 무시
+    void drain(int timeoutMs);
+    bool handedOffToSuccessor() const { return handoff.handedOff(); }
+    bool takeoverAbandoned() const { return handoff.takeoverAbandoned(); }
     void broadcastGameState(const MessageData& gameState);
     void sendToPlayer(int playerId, const std::string& message);
-}; 
\ No newline at end of file
+    // 이미 인코딩된 프레임 전송 (게이트웨이 모드에서 시뮬레이션이 보낸 프레임)
+    void sendFrame(int playerId, const FramePtr& frame);
+    void broadcastFrame(const FramePtr& frame);
+    // 스레드 안전. 플레이어 연결을 닫고 재연결 세션도 폐기 (게이트웨이가 시뮬레이션 프로세스를 잃었을 때)
+    void disconnectPlayer(int playerId);
+};
@@ -0,0 +1,51 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+// 플레이어 ID 할당기
+// 각 리액터가 전역 카운터에서 ID 블록을 통째로 받아 두고 로컬에서 나눠 주므로
+// 여러 스레드가 동시에 수락해도 충돌이 없고, 원자 연산은 BLOCK_SIZE번에 한 번만 일어납니다.
+// ID는 [firstId, firstId + rangeSize) 범위 안에서만 나오고 끝에 닿으면 처음으로 돌아갑니다.
+// 한 바퀴 돈 뒤 아직 쓰이는 ID를 건너뛰는 것은 호출한 쪽(NetworkManager)이 확인합니다.
+class PlayerIdAllocator {
+public:
+    static const int BLOCK_SIZE = 256;
+    // 여러 게이트웨이가 한 시뮬레이션 프로세스를 공유할 때 게이트웨이마다 쓰는 ID 범위
+    // 게이트웨이 g는 [g * GATEWAY_ID_RANGE + 1, (g + 1) * GATEWAY_ID_RANGE) 를 사용 (g < MAX_GATEWAYS)
+    static const int GATEWAY_ID_RANGE = 1 << 20;
+    static const int MAX_GATEWAYS = 2048;  // 마지막 게이트웨이 범위의 끝이 INT_MAX
+
+    explicit PlayerIdAllocator(int first = 1, int size = INT32_MAX - 1) :
+        firstId(first), rangeSize(size), cursor(0) {}
+
+    // 게이트웨이 번호에 해당하는 ID 범위로 만든 할당기
+    static PlayerIdAllocator forGateway(int gatewayId) {
+        return PlayerIdAllocator(gatewayId * GATEWAY_ID_RANGE + 1, GATEWAY_ID_RANGE - 1);
+    }
+
+    // 리액터별로 보관하는 ID 블록
+    struct Block {
+        int next = 0;
+        int end = 0;
+    };
+
+    int allocate(Block& block) {
+        if (block.next == block.end) {
+            // 범위 끝에 걸친 블록은 잘라 쓰고, 다음 블록부터 범위 처음으로 돌아감
+            int64_t offset = cursor.fetch_add(BLOCK_SIZE, std::memory_order_relaxed) % rangeSize;
+            block.next = firstId + static_cast<int>(offset);
+            block.end = firstId + static_cast<int>(std::min<int64_t>(offset + BLOCK_SIZE, rangeSize));
+        }
+        return block.next++;
+    }
+
+    // 지금까지 블록으로 나눠 준 위치 (무중단 재시작 시 후임 프로세스가 이어서 할당)
+    int64_t nextUnallocated() const { return cursor.load(); }
+    void resumeFrom(int64_t position) { cursor.store(position); }
+
+private:
+    int firstId;
+    int rangeSize;
+    std::atomic<int64_t> cursor;  // 단조 증가 (범위 안의 위치는 rangeSize로 나눈 나머지)
+};
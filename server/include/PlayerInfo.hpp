@@ -4,6 +4,7 @@
 #include <map>
 #include <string>
 #include <iostream>
+#include <random>
 #include "Event.hpp"
 #include "SimpleMessagePack.hpp"
 
@@ -20,6 +21,10 @@ private:
     std::vector<int> currentPos;
     int currentBlockType;
     MessageData currentPiece;  // 추가된 멤버 변수
+    // 조각 순서용 난수 생성기: 시드와 뽑은 횟수만으로 상태를 되살릴 수 있음 (방을 다른 프로세스로 옮길 때)
+    std::mt19937 pieceGenerator;
+    uint32_t pieceSeed;
+    uint64_t piecesDrawn;
 
 public:
     PlayerInfo(EventBus& bus);
@@ -52,7 +57,8 @@ public:
     friend class GameManager;
 
     // 기본 생성자 추가
-    PlayerInfo() : eventBus(GlobalEventBus::getInstance()), socket(-1), score(0), isReady(false) {
+    PlayerInfo() : eventBus(GlobalEventBus::getInstance()), socket(-1), score(0), isReady(false),
+                   pieceSeed(0), piecesDrawn(0) {
         board = std::vector<std::vector<int>>(20, std::vector<int>(10, 0));
         currentPos = {0, 5};
         currentBlockType = 0;
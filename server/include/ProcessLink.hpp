@@ -0,0 +1,64 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "BufferPool.hpp"
+#include "FrameDecoder.hpp"
+#include "RingBuffer.hpp"
+
+// 같은 호스트의 서버 프로세스끼리 레코드를 주고받는 AF_UNIX 스트림 링크 (게이트웨이 ↔ 시뮬레이션)
+// 레코드는 클라이언트 프레임과 같은 4바이트 빅엔디언 길이 접두사로 구분합니다.
+// 수신은 전용 스레드에서 콜백으로 넘기고, 송신은 큐에 넣으면 송신 스레드가 보내므로
+// 호출한 쪽(게임 이벤트 처리, 리액터)은 상대 프로세스가 느려도 막히지 않습니다.
+class ProcessLink {
+public:
+    using RecordHandler = std::function<void(const char* data, size_t length)>;
+    using CloseHandler = std::function<void()>;
+
+    // 연결된 소켓의 소유권을 넘겨받음 (start() 전에는 콜백을 부르지 않음)
+    // maxQueuedBytes: 상대가 읽지 않아 송신 큐가 이보다 커지면 링크를 끊음
+    ProcessLink(int socket, uint32_t maxRecordSize, size_t maxQueuedBytes);
+    ~ProcessLink();
+
+    ProcessLink(const ProcessLink&) = delete;
+    ProcessLink& operator=(const ProcessLink&) = delete;
+
+    // 수신/송신 스레드 시작. 콜백은 수신 스레드에서 호출되며 그 안에서 링크를 해제하면 안 됨
+    void start(RecordHandler onRecord, CloseHandler onClose);
+
+    // 레코드 하나를 송신 큐에 추가 (스레드 안전). 링크가 닫혔거나 큐 한도를 넘으면 false
+    bool send(const std::string& record);
+
+    void close();
+    bool isOpen() const { return open; }
+
+    // AF_UNIX 스트림 소켓 연결/리슨 ('@'로 시작하면 추상 네임스페이스). 실패하면 std::runtime_error
+    static int connectUnix(const std::string& path);
+    static int listenUnix(const std::string& path);
+
+private:
+    static const size_t READ_CHUNK = 64 * 1024;
+
+    int socket;
+    size_t maxQueuedBytes;
+    std::atomic<bool> open;
+
+    BufferPool bufferPool{READ_CHUNK * 4, 2};  // 수신 버퍼를 읽을 때마다 새로 할당하지 않도록 보관
+    RingBuffer inbound;
+    FrameDecoder decoder;
+
+    std::mutex outboxMutex;
+    std::condition_variable outboxReady;
+    std::string outbox;  // 길이 헤더까지 붙인 레코드들
+
+    std::thread reader;
+    std::thread writer;
+
+    void readLoop(RecordHandler onRecord, CloseHandler onClose);
+    void writeLoop();
+};
@@ -0,0 +1,71 @@
+#pragma once
+#include <functional>
+#include <vector>
+#include "Connection.hpp"
+#include "EventLoop.hpp"
+#include "ServerConfig.hpp"
+#include "SimpleMessagePack.hpp"
+
+// 무중단 재시작의 양쪽 진행 상태 (주고받는 형식은 HotRestart.hpp)
+//   이전 프로세스: --handoff 소켓에서 후임을 기다리고, 리액터를 모두 멈춘 뒤 상태와 fd를 넘김
+//   후임 프로세스: --takeover 소켓으로 상태와 fd를 받아 리스너/연결/세션/게임을 복원한 뒤 ACK,
+//                 이전 프로세스의 확정 ACK를 받아야 서비스 시작
+// 리스너를 나누어 붙이거나 샤드에 연결을 등록하는 일은 NetworkManager가 하고,
+// 이 클래스는 소켓과 fd 목록, 연결 하나의 송수신 대기 데이터를 주고받는 일을 맡습니다.
+class RestartHandoff {
+public:
+    explicit RestartHandoff(const ServerConfig& config);
+
+    RestartHandoff(const RestartHandoff&) = delete;
+    RestartHandoff& operator=(const RestartHandoff&) = delete;
+
+    // --- 넘겨받는 쪽 ---
+
+    // 이전 프로세스에서 상태와 fd를 받음. 리스너 구성이 다르면 받은 fd를 닫고 std::runtime_error
+    // (이 프로세스가 종료하면 이전 프로세스가 서비스를 재개)
+    void receive(int reactorCount);
+    bool takingOver() const { return takeoverSocket >= 0; }
+    const MessageData& takenState() const { return takeoverState; }
+    // 상태에 적힌 fd 순번 → 넘겨받은 fd (-1이면 없음)
+    int inherited(const MessageData& index) const;
+    // 이전 프로세스가 읽었지만 처리하지 못한 부분 프레임과, 보내지 못한 송신 큐를 연결에 되살림
+    void restoreConnection(const MessageData& saved, Connection& conn) const;
+    // 복원을 마쳤음을 이전 프로세스에 알리고 확정 ACK를 기다린 뒤 넘겨받은 상태를 버림.
+    // 확정받지 못하면 false: 이전 프로세스가 서비스를 재개하므로 넘겨받은 fd를 닫고 종료해야 함
+    bool finishTakeover();
+    // 확정받지 못한 넘겨받기 (종료할 때 이전 프로세스가 쓰는 소켓 경로와 게임 결과를 건드리지 않음)
+    bool takeoverAbandoned() const { return abandoned; }
+
+    // --- 넘겨주는 쪽 ---
+
+    // 후임 프로세스를 기다림. 같은 사용자의 후임이 접속하면 onSuccessor (리액터를 멈추게 함)
+    void openListener(EventLoop& loop, std::function<void()> onSuccessor);
+    void closeListener();
+    bool successorWaiting() const { return successor >= 0; }
+    // 넘길 fd 목록에 추가하고 상태에 적을 순번 반환 (fd가 음수면 -1)
+    int pass(int fd);
+    // 연결 하나의 상태 (fd는 pass로 목록에 추가됨)
+    MessageData saveConnection(const Connection& conn);
+    // 상태와 모아 둔 fd를 넘기고 ACK를 기다린 뒤 확정 ACK를 보냄.
+    // 확정 ACK를 보내기 전에 실패하면 false이고 이 프로세스가 그대로 서비스를 재개
+    bool handOff(const MessageData& state);
+    // 넘겼으면 종료할 때 소켓 경로를 지우지 않음 (후임이 사용 중)
+    bool handedOff() const { return completed; }
+
+private:
+    const ServerConfig& config;
+
+    int takeoverSocket = -1;  // 넘겨준 이전 프로세스 (복원을 마치면 ACK, 확정 ACK를 주고받은 뒤 닫음)
+    MessageData takeoverState;
+    std::vector<int> takeoverFds;
+    bool abandoned = false;
+
+    EventLoop* listenLoop = nullptr;
+    int listenSocket = -1;  // 후임 프로세스를 기다리는 소켓
+    int successor = -1;     // 접속한 후임 프로세스 (리액터를 모두 멈춘 뒤 handOff에서 상태를 넘김)
+    std::function<void()> onSuccessor;
+    std::vector<int> passedFds;
+    bool completed = false;
+
+    void acceptSuccessor();
+};
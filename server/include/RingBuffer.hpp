@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <sys/uio.h>
+#include "BufferPool.hpp"
+
+// 연결별 수신 링 버퍼
+// 소켓에서 빈 공간으로 바로 읽어 들이고(readv), 처리한 만큼 앞에서 소비합니다.
+// 용량은 항상 2의 거듭제곱이며 부족하면 두 배씩 늘어납니다.
+// 메모리는 리액터의 BufferPool에서 빌리고, 데이터를 모두 소비하면 바로 돌려줘
+// 유휴 연결은 수신 버퍼를 들고 있지 않습니다.
+class RingBuffer {
+private:
+    BufferPool* pool;  // nullptr이면 직접 할당
+    char* buffer;
+    size_t bufferSize;
+    size_t mask;
+    size_t readPos;   // 단조 증가하는 읽기 위치
+    size_t writePos;  // 단조 증가하는 쓰기 위치
+
+    char* allocate(size_t size);
+    void deallocate();
+
+public:
+    explicit RingBuffer(BufferPool* bufferPool = nullptr);
+    ~RingBuffer();
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    size_t size() const { return writePos - readPos; }
+    size_t capacity() const { return bufferSize; }
+    size_t freeSpace() const { return capacity() - size(); }
+    bool empty() const { return readPos == writePos; }
+
+    // 최소 minFree 바이트의 빈 공간 확보 (필요 시 할당 또는 확장)
+    void reserve(size_t minFree);
+
+    // 빈 공간을 최대 2개의 iovec으로 반환 (반환값: iovec 개수)
+    int writableSpans(iovec spans[2]);
+    void commitWrite(size_t length);
+    void write(const char* data, size_t length);
+
+    // offset 위치부터 length 바이트가 연속된 메모리면 포인터 반환, 아니면 nullptr
+    const char* contiguous(size_t offset, size_t length) const;
+    // offset 위치부터 length 바이트를 dst로 복사 (소비하지 않음)
+    void peek(size_t offset, char* dst, size_t length) const;
+    void consume(size_t length);
+    // 남은 데이터를 버리고 버퍼를 풀에 반납 (연결 슬롯 재사용)
+    void clear();
+};
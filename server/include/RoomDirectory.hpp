@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 방 → 서버 노드 배치
+// 모든 노드가 같은 노드 목록으로 같은 결과를 계산하므로 따로 조율하거나 저장할 필요가 없습니다.
+// rendezvous(HRW) 해싱: 방 이름과 노드 주소 쌍마다 점수를 매겨 가장 높은 노드가 방의 주인이며,
+// 노드를 추가/제거해도 그 노드가 1위였던 방만 옮겨 갑니다. (목록 순서는 결과에 영향 없음)
+// 실행 중인 방을 다른 노드로 옮기면 그 방만 assign()으로 지정한 노드가 해싱 결과보다 우선합니다.
+class RoomDirectory {
+public:
+    struct Node {
+        std::string host;
+        int port;
+    };
+
+    // nodes: "호스트:포트" 목록 (비어 있으면 모든 방이 이 노드 소속). 형식이 틀리면 std::runtime_error
+    RoomDirectory(const std::vector<std::string>& nodes, int selfIndex);
+
+    bool enabled() const { return !nodes.empty(); }
+    int ownerOf(const std::string& room) const;
+    bool isLocal(const std::string& room) const { return !enabled() || ownerOf(room) == selfIndex; }
+    const Node& node(int index) const { return nodes[index]; }
+    int size() const { return static_cast<int>(nodes.size()); }
+    int self() const { return selfIndex; }
+
+    // 방을 지정한 노드로 고정 (스레드 안전). 범위를 벗어난 번호면 false
+    bool assign(const std::string& room, int owner);
+
+private:
+    std::vector<Node> nodes;
+    std::vector<std::string> nodeKeys;  // 점수 계산에 쓰는 "호스트:포트"
+    int selfIndex;
+
+    mutable std::mutex overrideMutex;
+    std::unordered_map<std::string, int> overrides;  // 옮겨 간 방 → 노드 번호
+
+    static uint64_t score(const std::string& room, const std::string& nodeKey);
+};
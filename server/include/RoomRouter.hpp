@@ -0,0 +1,46 @@
+#pragma once
+#include <functional>
+#include <string>
+#include "Event.hpp"
+#include "RoomDirectory.hpp"
+#include "ServerConfig.hpp"
+#include "SessionRegistry.hpp"
+#include "SimpleMessagePack.hpp"
+
+// 방 라우팅과 실행 중인 방의 노드 간 이동
+// 다른 노드가 맡은 방으로 접속한 클라이언트는 그 노드로 안내하고(redirect),
+// 운영 도구의 room_* 관리 명령으로 방을 멈추고 스냅샷을 떠서 다른 노드로 옮깁니다.
+//
+// 옮기는 순서 (운영 도구가 두 노드의 AF_UNIX 소켓에 접속해 진행):
+//   1. 원래 노드 room_export {room}: 방을 멈추고 스냅샷 응답 (room_snapshot)
+//   2. 대상 노드 room_import {room, snapshot}: 새 ID로 복원하고 재연결 대기 세션을 만들어 토큰 응답 (room_imported)
+//   3. 원래 노드 room_commit {room, node, tokens}: 방을 대상 노드로 고정하고 플레이어에게 토큰과 함께 redirect
+// 2가 실패하면 원래 노드에서 room_resume {room}으로 다시 진행. 다른 노드들은 room_assign {room, node}로 갱신
+class RoomRouter {
+public:
+    // 플레이어(관리 연결 포함)에게 메시지 전송
+    using Sender = std::function<void(int playerId, const MessageData& message)>;
+
+    // 노드 목록이 잘못됐으면 std::runtime_error (RoomDirectory)
+    RoomRouter(const ServerConfig& config, EventBus& bus, SessionRegistry& sessions, Sender send);
+
+    bool isLocal(const std::string& room) const { return directory.isLocal(room); }
+
+    // 방을 맡은 노드로 재연결 안내 (이 노드에는 플레이어를 만들지 않음)
+    void redirect(int playerId, const std::string& room);
+
+    // room_* 관리 명령. trusted는 SO_PEERCRED로 서버와 같은 uid임을 확인한 AF_UNIX 연결인지 여부,
+    // allocatePlayerId는 명령을 처리 중인 리액터에서 새 플레이어 ID를 할당 (room_import)
+    void handleCommand(int requesterId, bool trusted, const std::string& command, const MessageData& msg,
+                       const std::function<int()>& allocatePlayerId);
+
+private:
+    const ServerConfig& config;
+    EventBus& eventBus;
+    SessionRegistry& sessions;
+    Sender send;
+    RoomDirectory directory;  // 방이 어느 노드 소속인지 (노드 목록이 없으면 모두 로컬)
+
+    void importRoom(int requesterId, const MessageData& msg, const std::function<int()>& allocatePlayerId);
+    void commitMove(int requesterId, const MessageData& msg);
+};
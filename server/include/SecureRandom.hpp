@@ -0,0 +1,11 @@
+#pragma once
+#include <cstdint>
+
+// 추측할 수 없어야 하는 토큰(재연결 세션, UDP 입력)용 난수
+// mt19937 같은 PRNG는 출력 몇 개로 내부 상태를 복원할 수 있으므로 커널 CSPRNG(getrandom)에서 읽습니다.
+class SecureRandom {
+public:
+    // 0이 아닌 63비트 토큰 (0은 잘못된 토큰으로 예약, 부호 없는 클라이언트에서도 같은 값)
+    // 커널에서 읽지 못하면 std::runtime_error
+    static int64_t token();
+};
@@ -0,0 +1,100 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 서버 실행 설정 (main.cpp에서 명령줄 인자로 채움)
+struct ServerConfig {
+    // 네트워크 I/O 백엔드 종류
+    enum class Backend { Epoll, IoUring };
+    // 프로세스 역할: 단독 실행, 게이트웨이(클라이언트 연결과 프레임 디코딩만), 시뮬레이션(게임 로직만)
+    enum class Role { Standalone, Gateway, Simulation };
+
+    int port = 12345;
+    Backend backend = Backend::Epoll;
+    Role role = Role::Standalone;
+    // 게이트웨이: 연결할 시뮬레이션 프로세스의 AF_UNIX 소켓들 (플레이어마다 하나에 배정)
+    // 시뮬레이션: 게이트웨이 연결을 받을 소켓 (첫 번째 경로만 사용)
+    std::vector<std::string> simulationPaths;
+    // 여러 게이트웨이가 한 시뮬레이션을 공유할 때 플레이어 ID가 겹치지 않도록 게이트웨이마다 다르게 지정 (0~2047)
+    int gatewayId = 0;
+
+    // 여러 서버 노드에 방을 나눠 배치 ("호스트:포트" 목록, 모든 노드가 같은 목록을 씀. 비어 있으면 단일 노드)
+    // connect의 room이 다른 노드 소속이면 그 노드 주소를 담은 redirect를 보냄
+    std::vector<std::string> nodes;
+    int nodeIndex = -1;  // nodes에서 이 노드의 위치
+
+    // 무중단 재시작 (단독 실행, epoll 백엔드, UDP 입력 채널 없이만 지원)
+    // handoffPath: 후임 프로세스를 기다리는 AF_UNIX 소켓. 접속하면 리액터를 멈추고 소켓과 상태를 넘긴 뒤 종료
+    // takeoverPath: 시작할 때 이 소켓의 이전 프로세스에서 소켓과 상태를 넘겨받음 (보통 handoffPath와 같은 경로)
+    std::string handoffPath;
+    std::string takeoverPath;
+    // 리액터(이벤트 루프 스레드) 수. 2 이상이면 SO_REUSEPORT 리슨 소켓을 리액터마다 엶
+    // 0이면 CPU 코어 수만큼 생성
+    int reactorCount = 1;
+    // UDP 입력 채널 포트 (0이면 사용하지 않음)
+    int udpPort = 0;
+    // 같은 호스트의 봇/게이트웨이용 AF_UNIX 리슨 소켓 경로 (비어 있으면 사용 안 함)
+    // '@'로 시작하면 추상 네임스페이스 (파일을 만들지 않음)
+    std::string unixPath;
+    // SOCK_SEQPACKET으로 열면 레코드 하나에 프레임 하나씩 주고받음 (기본은 SOCK_STREAM)
+    bool unixSeqPacket = false;
+    // AF_UNIX 연결이 shm_attach로 요청하면 memfd 공유 메모리 링으로 전송을 전환 (0이면 사용 안 함)
+    // 방향별 링 크기이며 최대 프레임이 들어가는 2의 거듭제곱으로 올림
+    size_t sharedRingSize = 256 * 1024;
+
+    // busy-poll 저지연 모드 (랭크 게임 등): 이 리스너로 들어온 연결이 있는 리액터는 이벤트가 없어도
+    // busySpinUs 동안 블로킹 없이 계속 확인한 뒤에야 커널 대기로 넘어감 (일반 리스너는 영향 없음)
+    int busyPollPort = 0;           // busy-poll 전용 TCP 리슨 포트 (0이면 사용 안 함)
+    bool unixBusyPoll = false;      // AF_UNIX 리스너도 busy-poll 모드로 처리
+    int busyPollUs = 50;            // SO_BUSY_POLL / epoll·io_uring 대기 중 NIC 큐 폴링 시간 (마이크로초)
+    int busyPollBudget = 8;         // SO_BUSY_POLL_BUDGET: 한 번 폴링에서 처리할 최대 패킷 수
+    int busySpinUs = 200;           // 유휴 상태에서 블로킹 대기로 넘어가기 전까지 스핀하는 시간
+
+    // 수신 프레임 최대 크기 (길이 헤더가 이보다 크면 버퍼를 할당하기 전에 연결 종료)
+    uint32_t maxFrameSize = 64 * 1024;
+
+    // 연결별 송신 큐 워터마크 (바이트)
+    // 상위 워터마크를 넘으면 게임 계층에 혼잡을 알리고, 하위 워터마크 아래로 내려가면 해소를 알림
+    size_t outboundHighWatermark = 256 * 1024;
+    size_t outboundLowWatermark = 64 * 1024;
+    // 이 크기를 넘으면 느린 클라이언트로 보고 연결을 끊음
+    size_t outboundMaxBytes = 4 * 1024 * 1024;
+    // 이 크기 이상의 프레임(방 전체 스냅샷 등)은 MSG_ZEROCOPY로 전송 (0이면 사용 안 함)
+    size_t zeroCopyThreshold = 0;
+
+    // 수락 제어: 한도를 넘으면 새 연결에 server_busy 프레임을 보내고 바로 닫음 (0이면 제한 없음)
+    int maxConnections = 10000;
+    int maxPendingHandshakes = 256;      // connect 메시지를 아직 보내지 않은 연결 수
+    int maxCongestedConnections = 64;    // 송신 큐가 상위 워터마크를 넘은 연결 수
+    double maxReactorLoad = 0.9;         // 수락하는 리액터 스레드의 CPU 사용률 (0~1)
+
+    // 연결별 게임 입력 속도 제한 (토큰 버킷): 초당 inputRate개, 순간 최대 inputBurst개까지 처리하고
+    // 넘치는 입력은 게임 계층에 전달하지 않고 버림 (0이면 제한 없음). ping/pong, connect/resume, 관리 명령은 제외
+    double inputRate = 30.0;
+    double inputBurst = 20.0;
+    // 같은 호스트의 AF_UNIX 연결(공유 메모리로 전환한 봇 포함)은 따로 제한 (기본: 제한 없음)
+    double localInputRate = 0.0;
+    double localInputBurst = 0.0;
+
+    // 하트비트: 수신이 없는 연결에 ping을 보내고, 유휴 시간이 지나면 연결 종료 (0이면 사용 안 함)
+    int heartbeatIntervalMs = 5000;
+    int idleTimeoutMs = 15000;
+    // 지연 측정: 수신 여부와 관계없이 이 간격마다 서버 시각을 실은 ping을 보내 RTT/지터/시계 오차를 잼
+    // (0이면 하트비트 ping에서만 측정)
+    int rttProbeIntervalMs = 2000;
+
+    // 연결이 끊긴 플레이어의 게임 상태를 보관하는 시간. 이 안에 재연결 토큰으로 resume하면
+    // 같은 플레이어로 이어서 진행 (0이면 끊기는 즉시 제거)
+    int sessionGraceMs = 30000;
+
+    // 종료 신호(SIGTERM/SIGINT)를 받으면 새 연결을 거절하고 진행 중인 게임이 끝날 때까지 최대 이 시간 동안 기다림
+    // (두 번째 신호를 받으면 기다리지 않고 바로 종료)
+    int drainTimeoutMs = 30000;
+    // 종료할 때 플레이어별 최종 점수를 덧붙여 기록할 파일 (비어 있으면 기록 안 함)
+    std::string resultsPath;
+
+    // 프레임마다 수신/해석/전송 내용을 출력 (디버깅용. 줄마다 write가 일어나므로 평소에는 끔)
+    bool verboseLog = false;
+};
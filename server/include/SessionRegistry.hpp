@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "Event.hpp"
+#include "EventLoop.hpp"
+#include "SimpleMessagePack.hpp"
+#include "TimerWheel.hpp"
+
+// 재연결 세션: 연결이 끊기면 유예 시간 동안 플레이어 상태를 보관하고 토큰으로 이어 받음
+// 토큰은 connect_response/resume_response로 클라이언트에 전달되고, resume 메시지로 같은 플레이어를 되찾습니다.
+// 유예 시간이 지나도록 resume하지 않은 플레이어는 client_disconnected를 발행해 게임 계층에서 제거합니다.
+//
+// 스레드 안전. 연결 경로와 함께 바꿔야 하는 호출(resume, 연결 종료)은 NetworkManager가 경로 뮤텍스를
+// 잡은 채로 호출하므로, 이 클래스는 다른 잠금을 잡은 채로 바깥을 호출하지 않습니다.
+class SessionRegistry {
+public:
+    // graceMs: 끊긴 플레이어를 보관하는 시간 (0 이하면 재연결 사용 안 함)
+    // 만료 확인은 loop 스레드에서 timers로 예약 (NetworkManager의 첫 번째 샤드)
+    SessionRegistry(int graceMs, EventLoop& loop, TimerWheel& timers, EventBus& bus);
+    ~SessionRegistry();
+
+    SessionRegistry(const SessionRegistry&) = delete;
+    SessionRegistry& operator=(const SessionRegistry&) = delete;
+
+    bool enabled() const { return graceMs > 0; }
+
+    // 플레이어의 재연결 토큰 (이미 있으면 같은 토큰)
+    int64_t issue(int playerId);
+    // 토큰의 세션을 다시 활성화하고 원래 플레이어 ID 반환 (없는 토큰이거나 요청한 플레이어 자신이면 -1)
+    int claim(int64_t token, int requesterId);
+    // 끊긴 플레이어를 유예 시간 동안 보관 (재연결을 쓰지 않거나 토큰이 없으면 false)
+    bool suspend(int playerId);
+    // 더 보관할 이유가 없는 세션 폐기 (다른 노드로 안내했거나 게임에서 제거됨)
+    void revoke(int playerId);
+    bool contains(int playerId) const;
+
+    // 무중단 재시작: 토큰 → {player_id, suspended, remaining_ms}
+    MessageData save() const;
+    void restore(const MessageData& saved);
+
+private:
+    struct Session {
+        int playerId;
+        bool suspended;       // 연결이 끊겨 resume을 기다리는 중
+        int64_t expiresAtMs;  // 유예 만료 시각 (CLOCK_MONOTONIC)
+    };
+
+    int graceMs;
+    EventLoop& eventLoop;
+    TimerWheel& timers;
+    EventBus& eventBus;
+
+    mutable std::mutex mutex;
+    std::unordered_map<int64_t, Session> sessions;  // 재연결 토큰 → 세션
+    std::unordered_map<int, int64_t> playerTokens;  // 플레이어 ID → 재연결 토큰
+
+    TimerWheel::Timer expiryTimer;  // 가장 먼저 만료되는 세션 시각에 맞춰 예약
+
+    void scheduleExpiry();
+    void expire();
+};
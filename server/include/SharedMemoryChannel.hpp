@@ -0,0 +1,53 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "SharedRing.hpp"
+#include "FrameDecoder.hpp"
+
+// 같은 호스트의 봇 프로세스와 프레임을 주고받는 공유 메모리 채널
+// memfd 하나에 방향별 SPSC 링 두 개를 두고, 도어벨 eventfd 두 개와 함께 AF_UNIX 소켓으로
+// (SCM_RIGHTS) 넘겨줍니다. 프레임 형식은 TCP와 같은 길이 접두사 스트림입니다.
+//
+// memfd 레이아웃 (봇도 같은 값으로 매핑):
+//   0      봇 → 서버 링 헤더 (SharedRingHeader)
+//   256    서버 → 봇 링 헤더
+//   4096   봇 → 서버 데이터 (ringSize 바이트)
+//   4096 + ringSize  서버 → 봇 데이터 (ringSize 바이트)
+class SharedMemoryChannel {
+public:
+    static const size_t DATA_OFFSET = 4096;
+
+    // ringSize는 최대 프레임(길이 헤더 포함)이 들어가는 2의 거듭제곱으로 올림. 실패하면 std::runtime_error
+    SharedMemoryChannel(size_t ringSize, uint32_t maxFrameSize);
+    ~SharedMemoryChannel();
+
+    SharedMemoryChannel(const SharedMemoryChannel&) = delete;
+    SharedMemoryChannel& operator=(const SharedMemoryChannel&) = delete;
+
+    SharedRing& inbound() { return toServer; }
+    SharedRing& outbound() { return toClient; }
+    FrameDecoder& decoder() { return frameDecoder; }
+    size_t ringSize() const { return ringBytes; }
+
+    int serverDoorbell() const { return serverEventFd; }  // 서버가 기다리는 eventfd (봇이 울림)
+    void drainDoorbell();
+    void notifyClient();                                  // 봇이 기다리는 eventfd를 울림
+
+    // frame을 memfd와 도어벨 fd들과 함께 한 번의 sendmsg로 전송 (논블로킹, 전부 못 보내면 false)
+    bool sendHandshake(int socket, const std::string& frame) const;
+
+private:
+    size_t ringBytes;
+    size_t mappingSize;
+    int memFd;
+    int serverEventFd;
+    int clientEventFd;
+    char* mapping;
+
+    SharedRing toServer;
+    SharedRing toClient;
+    FrameDecoder frameDecoder;
+
+    void release();
+};
@@ -0,0 +1,62 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <sys/uio.h>
+
+// 공유 메모리 SPSC 링의 헤더
+// 다른 프로세스(다른 언어의 봇 포함)가 그대로 매핑하므로 레이아웃을 고정합니다.
+//   0: head (u64)  소비자가 읽은 위치 (단조 증가, 소비자만 씀)
+//  64: tail (u64)  생산자가 쓴 위치 (단조 증가, 생산자만 씀)
+// 128: consumerWaiting (u32)  소비자가 도어벨을 기다리며 잠들려는 중
+// 192: producerWaiting (u32)  생산자가 빈 공간을 기다리는 중
+// 대기 플래그를 본 쪽이 0으로 바꾸고 상대의 eventfd에 한 번 씀 (플래그가 없으면 시스템 호출 없음)
+struct SharedRingHeader {
+    alignas(64) std::atomic<uint64_t> head;
+    alignas(64) std::atomic<uint64_t> tail;
+    alignas(64) std::atomic<uint32_t> consumerWaiting;
+    alignas(64) std::atomic<uint32_t> producerWaiting;
+};
+
+static_assert(sizeof(SharedRingHeader) == 256, "공유 링 헤더 레이아웃이 바뀌면 봇과 호환되지 않음");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "공유 메모리 원자 변수는 lock-free여야 함");
+
+// 공유 메모리 위의 SPSC 바이트 링 (서버 쪽 한 방향)
+// 한 객체는 소비자나 생산자 중 한 역할로만 씁니다.
+// 상대 프로세스가 쓰는 위치 값은 믿지 않고, 용량을 벗어나면 손상 상태로 표시합니다.
+// 소비자 쪽은 FrameDecoder가 RingBuffer와 같은 방식으로 읽을 수 있는 인터페이스를 제공합니다.
+class SharedRing {
+private:
+    SharedRingHeader* header;
+    char* data;
+    size_t ringCapacity;  // 2의 거듭제곱
+    size_t mask;
+    uint64_t readPos;     // 소비자: 자신이 읽은 위치
+    uint64_t writePos;    // 생산자: 자신이 쓴 위치
+    bool corrupted;
+
+public:
+    SharedRing();
+
+    void attach(SharedRingHeader* ringHeader, char* ringData, size_t capacity);
+
+    size_t capacity() const { return ringCapacity; }
+    bool isCorrupted() const { return corrupted; }
+
+    // 소비자 (FrameDecoder용)
+    size_t size();
+    void reserve(size_t) {}  // 용량이 고정이므로 확보할 수 없음 (최대 프레임보다 크게 만듦)
+    const char* contiguous(size_t offset, size_t length) const;
+    void peek(size_t offset, char* dst, size_t length) const;
+    void consume(size_t length);
+
+    // 생산자: spans를 빈 공간만큼 복사하고 한 번에 게시 (반환값: 복사한 바이트 수)
+    size_t write(const iovec* spans, int count);
+
+    // 잠들기 전에 대기 플래그를 세우고 다시 확인 (그사이 상대가 진행했으면 플래그를 내리고 false)
+    bool prepareConsumerWait();
+    bool prepareProducerWait();
+    // 상대가 대기 중이었으면 플래그를 내리고 true (호출한 쪽이 도어벨을 울림)
+    bool takeConsumerWaiting();
+    bool takeProducerWaiting();
+};
@@ -26,6 +26,8 @@ public:
     MessageData(int64_t value) : type(Integer), intValue(value) {}
     MessageData(double value) : type(Float), floatValue(value) {}
     MessageData(const std::string& value) : type(String), stringValue(value) {}
+    // 문자열 리터럴이 bool 생성자로 변환되지 않도록 명시
+    MessageData(const char* value) : type(String), stringValue(value) {}
     
     // 맵 생성자
     MessageData(const std::map<std::string, MessageData>& value) : type(Object), objectValue(value) {}
@@ -62,6 +64,7 @@ public:
     
     // 직렬화/역직렬화 메서드
     std::string serialize() const;
+    void serializeTo(std::string& out) const;  // 중간 문자열 없이 out 뒤에 이어 씀
     static MessageData deserialize(const std::string& data);
 
     // MessageData 클래스에 추가
@@ -192,19 +195,17 @@ class SimpleMessagePack {
 public:
     // MessageData를 바이너리 형식으로 변환
     static std::string pack(const MessageData& data) {
-        std::string serialized = data.serialize();
-        uint32_t size = serialized.size();
+        // 길이 헤더 자리를 비워 두고 본문을 바로 뒤에 직렬화 (복사 없음)
+        std::string result(4, 0);
+        data.serializeTo(result);
+        uint32_t size = result.size() - 4;
         
-        // 메시지 길이 정보 추가 (4바이트)
-        std::string result(4 + size, 0);
+        // 메시지 길이 정보 기록 (4바이트)
         result[0] = (size >> 24) & 0xFF;
         result[1] = (size >> 16) & 0xFF;
         result[2] = (size >> 8) & 0xFF;
         result[3] = size & 0xFF;
         
-        // 직렬화된 데이터 복사
-        std::copy(serialized.begin(), serialized.end(), result.begin() + 4);
-        
         return result;
     }
     
@@ -212,4 +213,8 @@ public:
     static MessageData unpack(const std::string& data) {
         return MessageData::deserialize(data);
     }
+
+    // 클라이언트가 보낸 표준 MessagePack을 MessageData로 변환
+    // nil/bool/정수/실수/문자열/bin/배열/맵(문자열 키)을 지원하며 (bin은 바이트 그대로 문자열로), 잘렸거나 지원하지 않는 형식이면 std::runtime_error
+    static MessageData unpackMsgPack(const char* data, size_t length);
 }; 
\ No newline at end of file
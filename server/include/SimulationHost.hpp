@@ -0,0 +1,46 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Event.hpp"
+#include "ProcessLink.hpp"
+#include "ServerConfig.hpp"
+
+// 시뮬레이션 모드: 클라이언트 소켓 없이 게이트웨이가 넘긴 입력 이벤트로 게임을 진행하고,
+// 결과 상태를 클라이언트 프레임으로 인코딩해 그 플레이어의 게이트웨이로 돌려보냅니다.
+// 게이트웨이는 여러 개가 붙을 수 있으며, 끊기면 그 게이트웨이의 플레이어는 연결 종료로 처리합니다.
+class SimulationHost {
+public:
+    // 설정의 시뮬레이션 소켓 경로에 리슨. 실패하면 std::runtime_error
+    SimulationHost(const ServerConfig& config, EventBus& bus);
+    ~SimulationHost();
+
+    SimulationHost(const SimulationHost&) = delete;
+    SimulationHost& operator=(const SimulationHost&) = delete;
+
+    // stop()할 때까지 게이트웨이 연결을 받음
+    void run();
+    void stop();
+
+private:
+    EventBus& eventBus;
+    std::string path;
+    int listenSocket;
+    std::atomic<bool> running;
+
+    // 게이트웨이 링크는 수락 스레드가 추가하고, 이벤트 처리(링크 수신 스레드)가 조회
+    std::mutex gatewayMutex;
+    std::unordered_map<int, std::unique_ptr<ProcessLink>> gateways;  // 게이트웨이 번호 → 링크
+    std::unordered_map<int, int> playerGateways;                     // 플레이어 → 게이트웨이 번호
+    int nextGatewayId;
+
+    void setupEventHandlers();
+    void acceptGateway(int socket);
+    void handleRecord(int gateway, const char* data, size_t length);
+    void handleGatewayClosed(int gateway);
+    void sendFrame(int playerId, const std::string& frame);
+    void broadcastFrame(const std::string& frame);
+};
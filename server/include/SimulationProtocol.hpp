@@ -0,0 +1,75 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "SimpleMessagePack.hpp"
+
+// 게이트웨이 ↔ 시뮬레이션 프로세스 레코드 (ProcessLink 레코드 하나의 본문)
+//
+//   이벤트 (게이트웨이 → 시뮬레이션): [1][이름 길이 1바이트][이벤트 이름][MessageData 직렬화]
+//     게이트웨이가 디코딩/검증을 마친 게임 입력 이벤트를 그대로 시뮬레이션의 이벤트 버스에 발행
+//   프레임 (시뮬레이션 → 게이트웨이): [2][플레이어 ID 4바이트 빅엔디언][길이 헤더까지 인코딩된 클라이언트 프레임]
+//     플레이어 ID가 -1이면 그 시뮬레이션이 맡은 모든 플레이어에게 브로드캐스트
+class SimulationProtocol {
+public:
+    enum RecordType : uint8_t { EVENT_RECORD = 1, FRAME_RECORD = 2 };
+    static constexpr int BROADCAST = -1;
+
+    // 방 전체 스냅샷 프레임까지 담을 수 있는 레코드 최대 크기와, 상대가 멈췄다고 보는 송신 큐 크기
+    static constexpr uint32_t MAX_RECORD_SIZE = 16 * 1024 * 1024;
+    static constexpr size_t MAX_QUEUED_BYTES = 64 * 1024 * 1024;
+
+    static std::string encodeEvent(const std::string& name, const MessageData& data) {
+        std::string record;
+        record.push_back(static_cast<char>(EVENT_RECORD));
+        // 이벤트 이름은 코드에 고정된 짧은 문자열
+        record.push_back(static_cast<char>(name.size()));
+        record.append(name);
+        data.serializeTo(record);
+        return record;
+    }
+
+    static std::string encodeFrame(int playerId, const std::string& frame) {
+        std::string record;
+        record.reserve(5 + frame.size());
+        record.push_back(static_cast<char>(FRAME_RECORD));
+        uint32_t id = static_cast<uint32_t>(playerId);
+        record.push_back(static_cast<char>((id >> 24) & 0xFF));
+        record.push_back(static_cast<char>((id >> 16) & 0xFF));
+        record.push_back(static_cast<char>((id >> 8) & 0xFF));
+        record.push_back(static_cast<char>(id & 0xFF));
+        record.append(frame);
+        return record;
+    }
+
+    // 레코드 종류 (길이가 모자라면 0)
+    static uint8_t recordType(const char* data, size_t length) {
+        return length > 0 ? static_cast<uint8_t>(data[0]) : 0;
+    }
+
+    static bool decodeEvent(const char* data, size_t length, std::string& name, MessageData& eventData) {
+        if (length < 2) {
+            return false;
+        }
+        size_t nameLength = static_cast<uint8_t>(data[1]);
+        if (length < 2 + nameLength + 1) {
+            return false;
+        }
+        name.assign(data + 2, nameLength);
+        eventData = MessageData::deserialize(std::string(data + 2 + nameLength, length - 2 - nameLength));
+        return true;
+    }
+
+    // frame은 레코드 안을 가리킴 (복사 없음)
+    static bool decodeFrame(const char* data, size_t length, int& playerId, const char*& frame, size_t& frameLength) {
+        if (length < 5) {
+            return false;
+        }
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+        playerId = static_cast<int>((static_cast<uint32_t>(bytes[1]) << 24) | (static_cast<uint32_t>(bytes[2]) << 16) |
+                                    (static_cast<uint32_t>(bytes[3]) << 8) | bytes[4]);
+        frame = data + 5;
+        frameLength = length - 5;
+        return true;
+    }
+};
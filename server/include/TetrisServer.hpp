@@ -1,20 +1,40 @@
 #pragma once
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
 #include "GameManager.hpp"
+#include "GatewayBridge.hpp"
 #include "NetworkManager.hpp"
 #include "Event.hpp"
 #include "PlayerInfo.hpp"
+#include "ServerConfig.hpp"
+#include "SimulationHost.hpp"
 
 class TetrisServer {
 private:
     EventBus& eventBus;
     PlayerInfo playerInfo;
-    GameManager gameManager;
-    NetworkManager networkManager;
+    // 역할에 따라 일부만 생성 (게이트웨이는 게임 로직 없이, 시뮬레이션은 클라이언트 소켓 없이 실행)
+    std::unique_ptr<GameManager> gameManager;
+    std::unique_ptr<NetworkManager> networkManager;
+    // 프로세스 간 연결은 게임/네트워크 계층보다 먼저 해제되어야 함
+    std::unique_ptr<GatewayBridge> gatewayBridge;
+    std::unique_ptr<SimulationHost> simulationHost;
+
+    int drainTimeoutMs;
+    std::string resultsPath;
+    bool resultsSaved = false;  // server_shutdown 처리 중에만 바뀜 (이벤트 버스 뮤텍스로 보호)
+    std::thread signalThread;
+    std::atomic<bool> finished{false};
     
     void setupEventHandlers();
+    void waitForSignals();
+    void saveResults();
 
 public:
-    TetrisServer(int port);
-    void run();
+    TetrisServer(const ServerConfig& config);
+    // 오류로 끝났으면 false
+    bool run();
     void handleClientConnected(const Event& event);
-}; 
\ No newline at end of file
+}; 
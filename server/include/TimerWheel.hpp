@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "EventLoop.hpp"
+
+// 해시 타이머 휠 (이벤트 루프의 timerfd로 구동)
+// 만료 틱을 슬롯 수로 나눈 나머지 슬롯의 이중 연결 리스트에 타이머를 보관합니다.
+// 등록/취소는 O(1)이고, 틱마다 현재 슬롯의 타이머만 확인합니다.
+// 타이머는 소유 객체(Connection 등)에 내장되어 별도 할당이 없습니다.
+class TimerWheel {
+public:
+    struct Timer {
+        std::function<void()> onExpire;
+        uint64_t expiryTick = 0;
+        Timer* prev = nullptr;
+        Timer* next = nullptr;
+
+        Timer() = default;
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+
+        bool scheduled() const { return next != nullptr; }
+    };
+
+    // slotCount는 2의 거듭제곱으로 올림
+    TimerWheel(EventLoop& loop, int tickMs, size_t slotCount);
+    ~TimerWheel();
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    // delayTicks 틱 뒤에 만료 (이미 등록된 타이머는 다시 등록)
+    void schedule(Timer& timer, uint64_t delayTicks);
+    void cancel(Timer& timer);
+
+    uint64_t now() const { return currentTick; }
+    uint64_t toTicks(int ms) const { return (ms + tickMs - 1) / tickMs; }
+
+private:
+    EventLoop& eventLoop;
+    int timerFd;
+    int tickMs;
+    size_t mask;
+    std::vector<Timer> slots;  // 각 슬롯은 자기 자신을 가리키는 원형 리스트의 머리
+    uint64_t currentTick;
+    size_t activeTimers;       // 0이면 timerfd를 멈춰 유휴 서버가 깨어나지 않게 함
+
+    void link(Timer& timer);
+    static void unlink(Timer& timer);
+    void setArmed(bool armed);
+    void advance();
+};
@@ -0,0 +1,30 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+
+// 입력 속도 제한용 토큰 버킷
+// 초당 rate개씩 채워지고 최대 burst개까지 모입니다. 처음에는 가득 찬 상태로 시작합니다.
+struct TokenBucket {
+    double tokens = 0.0;
+    int64_t lastRefillNs = 0;
+
+    // 토큰 하나를 쓸 수 있으면 true (rate가 0 이하면 제한 없음)
+    bool take(double rate, double burst, int64_t nowNs) {
+        if (rate <= 0) {
+            return true;
+        }
+
+        if (lastRefillNs == 0) {
+            tokens = burst;
+        } else {
+            tokens = std::min(burst, tokens + (nowNs - lastRefillNs) * rate / 1e9);
+        }
+        lastRefillNs = nowNs;
+
+        if (tokens < 1.0) {
+            return false;
+        }
+        tokens -= 1.0;
+        return true;
+    }
+};
@@ -0,0 +1,78 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <netinet/in.h>
+#include "Event.hpp"
+#include "EventLoop.hpp"
+#include "SimpleMessagePack.hpp"
+#include "TokenBucket.hpp"
+
+// 입력 전용 UDP 채널 (TCP 스트림의 head-of-line 블로킹 회피)
+//
+// 클라이언트 → 서버 데이터그램 (빅엔디언):
+//   [토큰 8바이트][입력 개수 1바이트] + 입력마다 [시퀀스 4바이트][길이 2바이트][MessagePack 본문]
+// 클라이언트는 아직 ack 받지 못한 최근 입력들을 매 데이터그램에 함께 실어 보내고,
+// 서버는 시퀀스 번호로 이미 처리한 입력을 걸러낸 뒤 순서대로 client_message_received로 발행합니다.
+//
+// 서버 → 클라이언트 ack 데이터그램: [토큰 8바이트][마지막으로 처리한 시퀀스 4바이트]
+//
+// 데이터그램 시퀀스는 이 채널의 재전송용 번호일 뿐입니다. 게임 계층의 입력 번호(상태의 input_seq로 확인 응답)는
+// TCP와 같이 본문의 "seq" 필드를 쓰므로, 두 채널로 입력을 보내는 클라이언트는 하나의 카운터로 seq를 매깁니다.
+class UdpInputChannel {
+public:
+    using Decoder = std::function<MessageData(const char*, size_t)>;
+
+    // shuttingDown: 소유자(NetworkManager)의 종료 플래그. 켜진 뒤 도착한 입력은 TCP와 같이 버림
+    // inputRate/inputBurst: 세션별 입력 속도 제한 (0이면 제한 없음)
+    UdpInputChannel(int port, EventLoop& loop, EventBus& bus, Decoder decoder,
+                    const std::atomic<bool>& shuttingDown,
+                    double inputRate = 0.0, double inputBurst = 0.0);
+    ~UdpInputChannel();
+
+    UdpInputChannel(const UdpInputChannel&) = delete;
+    UdpInputChannel& operator=(const UdpInputChannel&) = delete;
+
+    // 플레이어의 인증 토큰 발급 (connect_response에 실어 보냄) / 연결 종료 시 폐기
+    int64_t issueToken(int playerId);
+    void revokeToken(int playerId);
+
+    int getPort() const { return port; }
+    uint64_t getDroppedInputs() const { return droppedInputs; }
+
+private:
+    static const int BATCH_SIZE = 32;
+    static const size_t MAX_DATAGRAM_SIZE = 1472;  // 이더넷 MTU에서 IP/UDP 헤더를 뺀 크기
+    static const size_t HEADER_SIZE = 9;
+    static const size_t INPUT_HEADER_SIZE = 6;
+    static const size_t ACK_SIZE = 12;
+
+    struct Session {
+        int playerId;
+        uint32_t lastSequence = 0;  // 마지막으로 처리한 입력 시퀀스 (0이면 아직 없음)
+        sockaddr_in peer{};         // ack를 보낼 주소 (NAT 재바인딩을 따라 갱신)
+        TokenBucket inputBucket;
+        uint64_t droppedInputs = 0;  // 속도 제한으로 버린 입력 수
+    };
+
+    int port;
+    int udpSocket;
+    EventLoop& eventLoop;
+    EventBus& eventBus;
+    Decoder decode;
+    const std::atomic<bool>& shuttingDown;
+    double inputRate;
+    double inputBurst;
+    std::atomic<uint64_t> droppedInputs;  // 속도 제한으로 버린 전체 입력 수
+
+    // 토큰 발급은 게임 이벤트 처리 중에, 수신은 리액터 스레드에서 일어남
+    std::mutex sessionMutex;
+    std::unordered_map<int64_t, Session> sessions;  // 토큰 → 세션
+    std::unordered_map<int, int64_t> playerTokens;
+
+    void receiveDatagrams();
+    void handleDatagram(const char* data, size_t length, const sockaddr_in& from);
+    void sendAck(int64_t token, uint32_t sequence, const sockaddr_in& peer);
+};
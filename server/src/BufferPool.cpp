@@ -0,0 +1,53 @@
+#include "BufferPool.hpp"
+
+BufferPool::BufferPool(size_t maxPooledSize, size_t maxCached) :
+    maxCachedPerClass(maxCached),
+    freeLists(classIndex(maxPooledSize) + 1) {
+}
+
+BufferPool::~BufferPool() {
+    for (auto& freeList : freeLists) {
+        for (char* buffer : freeList) {
+            delete[] buffer;
+        }
+    }
+}
+
+size_t BufferPool::classSize(size_t size) {
+    size_t result = MIN_CLASS_SIZE;
+    while (result < size) {
+        result <<= 1;
+    }
+    return result;
+}
+
+size_t BufferPool::classIndex(size_t size) {
+    size_t index = 0;
+    for (size_t classBytes = MIN_CLASS_SIZE; classBytes < size; classBytes <<= 1) {
+        ++index;
+    }
+    return index;
+}
+
+char* BufferPool::acquire(size_t size) {
+    size_t index = classIndex(size);
+    if (index < freeLists.size() && !freeLists[index].empty()) {
+        char* buffer = freeLists[index].back();
+        freeLists[index].pop_back();
+        return buffer;
+    }
+    return new char[classSize(size)];
+}
+
+void BufferPool::release(char* buffer, size_t size) {
+    if (!buffer) {
+        return;
+    }
+
+    size_t index = classIndex(size);
+    if (index < freeLists.size() && freeLists[index].size() < maxCachedPerClass) {
+        freeLists[index].push_back(buffer);
+        return;
+    }
+    delete[] buffer;
+}
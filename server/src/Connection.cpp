@@ -0,0 +1,65 @@
+#include "Connection.hpp"
+
+void Connection::reset(int clientSocket, int id) {
+    socket = clientSocket;
+    playerId = id;
+    inbound.clear();
+    decoder.reset();
+    outbound.clear();
+    outboundOffset = 0;
+    outboundBytes = 0;
+    congested = false;
+    handshaken = false;
+    closed = false;
+    unixSocket = false;
+    adminPeer = false;
+    maxRecordSize = 0;
+    busyPoll = false;
+    sharedChannel.reset();
+    zeroCopy = false;
+    zeroCopyNextId = 0;
+    zeroCopyPending.clear();
+    inputBucket = TokenBucket();
+    droppedInputs = 0;
+    latency = LatencyEstimator();
+    lastActivityTick = 0;
+    lastPingTick = 0;
+}
+
+int Connection::fillOutboundSpans(iovec* spans, int maxSpans, size_t stopAtSize) const {
+    int count = 0;
+    size_t offset = outboundOffset;
+
+    for (const auto& frame : outbound) {
+        if (count == maxSpans || (count > 0 && frame->size() >= stopAtSize)) {
+            break;
+        }
+        spans[count].iov_base = const_cast<char*>(frame->data()) + offset;
+        spans[count].iov_len = frame->size() - offset;
+        ++count;
+        offset = 0;
+    }
+    return count;
+}
+
+void Connection::consumeOutbound(size_t length) {
+    outboundBytes -= length;
+
+    while (length > 0 && !outbound.empty()) {
+        size_t remaining = outbound.front()->size() - outboundOffset;
+        if (length < remaining) {
+            outboundOffset += length;
+            return;
+        }
+        length -= remaining;
+        outbound.pop_front();
+        outboundOffset = 0;
+    }
+}
+
+void Connection::releaseZeroCopy(uint32_t last) {
+    // 알림 번호는 sendmsg 순서대로 증가하고 커널도 순서대로 알리므로 last까지 앞에서부터 제거
+    while (!zeroCopyPending.empty() && static_cast<int32_t>(zeroCopyPending.front().first - last) <= 0) {
+        zeroCopyPending.pop_front();
+    }
+}
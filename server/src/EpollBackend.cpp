@@ -0,0 +1,256 @@
+#include "EpollBackend.hpp"
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <linux/errqueue.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+#include <algorithm>
+#include <iostream>
+
+EpollBackend::EpollBackend(EventLoop& loop, const Callbacks& cb, size_t threshold) :
+    eventLoop(loop),
+    callbacks(cb),
+    zeroCopyThreshold(threshold) {
+}
+
+void EpollBackend::addListener(int listenSocket) {
+    // 리슨 소켓이 준비되면 대기 중인 연결을 모두 수락 (엣지 트리거)
+    eventLoop.addFd(listenSocket, EPOLLIN | EPOLLET, [this, listenSocket](uint32_t) {
+        acceptClients(listenSocket);
+    });
+}
+
+void EpollBackend::addConnection(Connection& conn) {
+    if (zeroCopyThreshold > 0 && !conn.unixSocket) {
+        int opt = 1;
+        conn.zeroCopy = setsockopt(conn.socket, SOL_SOCKET, SO_ZEROCOPY, &opt, sizeof(opt)) == 0;
+    }
+
+    Connection* connection = &conn;
+    eventLoop.addFd(conn.socket, EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET,
+                    [this, connection](uint32_t events) {
+        handleClientEvents(*connection, events);
+    });
+}
+
+void EpollBackend::removeConnection(Connection& conn) {
+    eventLoop.removeFd(conn.socket);
+}
+
+int EpollBackend::runOnce(int timeoutMs) {
+    return eventLoop.runOnce(timeoutMs);
+}
+
+bool EpollBackend::setBusyPoll(unsigned usecs, unsigned budget) {
+    return eventLoop.setBusyPoll(usecs, budget);
+}
+
+void EpollBackend::acceptClients(int listenSocket) {
+    // 엣지 트리거이므로 백로그가 빌 때까지 수락
+    // 논블로킹/CLOEXEC는 accept4가 한 번에 설정 (주소는 쓰지 않으므로 받지 않음)
+    while (true) {
+        int clientSocket = accept4(listenSocket, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (clientSocket < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // EMFILE 등은 NetworkManager가 대기 연결을 정리함 (그대로 두면 엣지 트리거가 다시 오지 않음)
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                callbacks.onAcceptError(listenSocket, errno);
+            }
+            return;
+        }
+
+        callbacks.onAccept(listenSocket, clientSocket);
+    }
+}
+
+void EpollBackend::handleClientEvents(Connection& conn, uint32_t events) {
+    // zerocopy 완료 알림도 EPOLLERR로 오므로 에러 큐를 비운 뒤 실제 소켓 오류인지 확인
+    bool socketError = events & EPOLLERR;
+    if (socketError && zeroCopyThreshold > 0) {
+        reapZeroCopyCompletions(conn);
+        int error = 0;
+        socklen_t length = sizeof(error);
+        socketError = getsockopt(conn.socket, SOL_SOCKET, SO_ERROR, &error, &length) < 0 || error != 0;
+    }
+
+    if (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+        bool peerClosed = false;
+        bool received = false;
+
+        // 링 버퍼의 빈 공간으로 바로 읽음. 요청보다 적게 읽히면 소켓 버퍼가 빈 것이므로
+        // EAGAIN 확인용 recv를 추가로 호출하지 않음. 단 EPOLLRDHUP이 함께 왔으면 마지막 데이터와 FIN이
+        // 한 번에 도착한 것일 수 있고 엣지 트리거는 다시 오지 않으므로 0바이트 읽기까지 확인
+        bool peerShutdown = events & EPOLLRDHUP;
+        // SEQPACKET 연결은 레코드가 잘리지 않도록 최대 레코드 크기만큼 비워 두고 한 레코드씩 읽음
+        bool records = conn.maxRecordSize > 0;
+        size_t minFree = records ? conn.maxRecordSize : 1;
+        size_t readSpace = std::max(minFree, static_cast<size_t>(MIN_READ_SPACE));
+        while (true) {
+            if (conn.inbound.freeSpace() < minFree) {
+                // 가득 찼으면 먼저 프레임을 처리해 공간을 비우고, 그래도 부족하면 확장
+                // (비어 있으면 버퍼를 풀에 돌려준 상태이므로 새로 빌림)
+                if (!conn.inbound.empty()) {
+                    callbacks.onReadable(conn);
+                    received = false;
+                    if (conn.closed) {
+                        return;
+                    }
+                }
+                conn.inbound.reserve(readSpace);
+            }
+
+            iovec spans[2];
+            int spanCount = conn.inbound.writableSpans(spans);
+            size_t requested = spans[0].iov_len + (spanCount > 1 ? spans[1].iov_len : 0);
+
+            ssize_t bytesRead;
+            if (records) {
+                // MSG_TRUNC: 레코드가 요청보다 크면 잘린 길이 대신 원래 길이를 돌려받음
+                msghdr msg{};
+                msg.msg_iov = spans;
+                msg.msg_iovlen = spanCount;
+                bytesRead = recvmsg(conn.socket, &msg, MSG_TRUNC);
+                if (bytesRead > 0 && static_cast<size_t>(bytesRead) > requested) {
+                    std::cerr << "플레이어 " << conn.playerId << " 레코드 크기 초과 (" << bytesRead
+                              << " 바이트), 연결 종료" << std::endl;
+                    callbacks.onClosed(conn);
+                    return;
+                }
+            } else {
+                bytesRead = readv(conn.socket, spans, spanCount);
+            }
+            if (bytesRead > 0) {
+                conn.inbound.commitWrite(bytesRead);
+                received = true;
+                if (!records && !peerShutdown && static_cast<size_t>(bytesRead) < requested) {
+                    break;
+                }
+                continue;
+            }
+            if (bytesRead < 0 && errno == EINTR) {
+                continue;
+            }
+            if (bytesRead < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break;
+            }
+            peerClosed = true;
+            break;
+        }
+
+        // 이번에 읽은 데이터의 완성된 프레임을 한 번에 처리
+        if (received) {
+            callbacks.onReadable(conn);
+        }
+        if (conn.closed) {
+            return;
+        }
+        if (peerClosed || (events & EPOLLHUP) || socketError) {
+            callbacks.onClosed(conn);
+            return;
+        }
+    }
+
+    if ((events & EPOLLOUT) && !conn.closed) {
+        flush(conn);
+    }
+}
+
+void EpollBackend::flush(Connection& conn) {
+    bool progressed = false;
+
+    // 대기 프레임을 sendmsg 한 번으로 모아서 전송
+    // 큰 프레임은 따로 MSG_ZEROCOPY로 보내 수신자마다 커널 버퍼로 복사하지 않음
+    while (!conn.outbound.empty()) {
+        iovec spans[MAX_SEND_SPANS];
+        msghdr msg{};
+        msg.msg_iov = spans;
+
+        const FramePtr& head = conn.outbound.front();
+        bool zeroCopy = conn.zeroCopy && head->size() >= zeroCopyThreshold;
+        if (zeroCopy) {
+            spans[0].iov_base = const_cast<char*>(head->data()) + conn.outboundOffset;
+            spans[0].iov_len = head->size() - conn.outboundOffset;
+            msg.msg_iovlen = 1;
+        } else {
+            // SEQPACKET은 sendmsg 한 번이 레코드 하나이므로 프레임을 하나씩 보냄
+            size_t stopAtSize = conn.zeroCopy ? zeroCopyThreshold : SIZE_MAX;
+            int maxSpans = conn.maxRecordSize > 0 ? 1 : MAX_SEND_SPANS;
+            msg.msg_iovlen = conn.fillOutboundSpans(spans, maxSpans, stopAtSize);
+        }
+
+        ssize_t bytesSent = sendmsg(conn.socket, &msg, MSG_NOSIGNAL | (zeroCopy ? MSG_ZEROCOPY : 0));
+        if (bytesSent > 0) {
+            if (zeroCopy) {
+                // 성공한 zerocopy 호출마다 완료 알림 번호가 하나씩 증가
+                conn.zeroCopyPending.emplace_back(conn.zeroCopyNextId++, head);
+            }
+            conn.consumeOutbound(bytesSent);
+            progressed = true;
+            continue;
+        }
+        if (bytesSent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytesSent < 0 && errno == ENOBUFS && zeroCopy) {
+            // 고정 페이지 한도(optmem)를 넘으면 이 연결은 일반 전송으로 전환
+            conn.zeroCopy = false;
+            continue;
+        }
+        if (bytesSent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            // 나머지는 EPOLLOUT 이벤트에서 전송
+            break;
+        }
+
+        // 보낼 수 없는 연결이므로 큐를 비움 (종료는 수신 쪽 HUP/ERR 이벤트에서 처리)
+        std::cerr << "메시지 전송 실패: " << strerror(errno) << std::endl;
+        conn.outbound.clear();
+        conn.outboundOffset = 0;
+        conn.outboundBytes = 0;
+        progressed = true;
+        break;
+    }
+
+    if (progressed) {
+        callbacks.onSent(conn);
+    }
+}
+
+void EpollBackend::reapZeroCopyCompletions(Connection& conn) {
+    while (true) {
+        char control[128];
+        msghdr msg{};
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        if (recvmsg(conn.socket, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+            break;
+        }
+
+        for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+            bool recvErr = (cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) ||
+                           (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR);
+            if (!recvErr) {
+                continue;
+            }
+
+            const sock_extended_err* err = reinterpret_cast<const sock_extended_err*>(CMSG_DATA(cmsg));
+            if (err->ee_errno != 0 || err->ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+                continue;
+            }
+
+            // [ee_info, ee_data] 범위의 전송이 끝나 커널이 버퍼를 놓아줌
+            conn.releaseZeroCopy(err->ee_data);
+
+            // 루프백 등 커널이 결국 복사한 경우 zerocopy는 비용만 들므로 끔
+            if ((err->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) && conn.zeroCopy) {
+                conn.zeroCopy = false;
+                std::cout << "플레이어 " << conn.playerId << " zerocopy 비활성화 (커널이 복사로 처리)" << std::endl;
+            }
+        }
+    }
+}
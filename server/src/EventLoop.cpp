@@ -0,0 +1,136 @@
+#include "EventLoop.hpp"
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+EventLoop::EventLoop() {
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0) {
+        throw std::runtime_error("epoll 생성 실패: " + std::string(strerror(errno)));
+    }
+
+    wakeupFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeupFd < 0) {
+        close(epollFd);
+        throw std::runtime_error("eventfd 생성 실패: " + std::string(strerror(errno)));
+    }
+
+    addFd(wakeupFd, EPOLLIN, [this](uint32_t) {
+        uint64_t count;
+        while (read(wakeupFd, &count, sizeof(count)) > 0) {
+        }
+        runPendingTasks();
+    });
+}
+
+EventLoop::~EventLoop() {
+    close(wakeupFd);
+    close(epollFd);
+}
+
+void EventLoop::post(Task task) {
+    bool wasEmpty;
+    {
+        std::lock_guard<std::mutex> lock(taskMutex);
+        wasEmpty = pendingTasks.empty();
+        pendingTasks.push_back(std::move(task));
+    }
+
+    // 이미 대기 중인 작업이 있으면 깨우기 신호도 이미 보낸 상태
+    if (wasEmpty) {
+        uint64_t one = 1;
+        ssize_t written = write(wakeupFd, &one, sizeof(one));
+        (void)written;
+    }
+}
+
+void EventLoop::runPendingTasks() {
+    std::vector<Task> tasks;
+    {
+        std::lock_guard<std::mutex> lock(taskMutex);
+        tasks.swap(pendingTasks);
+    }
+
+    for (auto& task : tasks) {
+        task();
+    }
+}
+
+void EventLoop::addFd(int fd, uint32_t events, Handler handler) {
+    epoll_event ev{};
+    ev.events = events;
+    ev.data.fd = fd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+        throw std::runtime_error("epoll 등록 실패: " + std::string(strerror(errno)));
+    }
+    handlers[fd] = std::make_unique<Handler>(std::move(handler));
+}
+
+void EventLoop::modifyFd(int fd, uint32_t events) {
+    epoll_event ev{};
+    ev.events = events;
+    ev.data.fd = fd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev) < 0) {
+        std::cerr << "epoll 변경 실패: " << strerror(errno) << std::endl;
+    }
+}
+
+void EventLoop::removeFd(int fd) {
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+
+    auto it = handlers.find(fd);
+    if (it != handlers.end()) {
+        retiredHandlers.push_back(std::move(it->second));
+        handlers.erase(it);
+    }
+}
+
+bool EventLoop::setBusyPoll(unsigned usecs, unsigned budget) {
+#ifdef EPIOCSPARAMS
+    // epoll 인스턴스 단위 busy poll (리눅스 6.9 이상)
+    epoll_params params{};
+    params.busy_poll_usecs = usecs;
+    params.busy_poll_budget = static_cast<uint16_t>(budget);
+    params.prefer_busy_poll = usecs > 0;
+    if (ioctl(epollFd, EPIOCSPARAMS, &params) < 0) {
+        std::cerr << "epoll busy poll 설정 실패: " << strerror(errno) << std::endl;
+        return false;
+    }
+    return true;
+#else
+    (void)usecs;
+    (void)budget;
+    return false;
+#endif
+}
+
+int EventLoop::runOnce(int timeoutMs) {
+    epoll_event events[MAX_EVENTS];
+
+    int count = epoll_wait(epollFd, events, MAX_EVENTS, timeoutMs);
+    if (count < 0) {
+        if (errno != EINTR) {
+            std::cerr << "epoll 대기 실패: " << strerror(errno) << std::endl;
+        }
+        return 0;
+    }
+
+    for (int i = 0; i < count; ++i) {
+        // 같은 배치에서 앞선 콜백이 해제한 fd는 건너뜀
+        auto it = handlers.find(events[i].data.fd);
+        if (it == handlers.end()) {
+            continue;
+        }
+        Handler* handler = it->second.get();
+        (*handler)(events[i].events);
+    }
+
+    retiredHandlers.clear();
+    return count;
+}
@@ -0,0 +1,63 @@
+#include "FrameDecoder.hpp"
+
+template <typename Buffer>
+size_t FrameDecoder::decodeFrames(Buffer& buffer, const FrameHandler& onFrame) {
+    size_t frames = 0;
+
+    while (state != State::Failed) {
+        if (state == State::Header) {
+            if (buffer.size() < 4) {
+                break;
+            }
+
+            unsigned char header[4];
+            buffer.peek(0, reinterpret_cast<char*>(header), 4);
+            buffer.consume(4);
+
+            // 메시지 길이 계산
+            frameSize =
+                ((uint32_t)header[0] << 24) |
+                ((uint32_t)header[1] << 16) |
+                ((uint32_t)header[2] << 8) |
+                (uint32_t)header[3];
+
+            // 상대가 보낸 길이를 믿고 버퍼를 키우기 전에 상한 확인
+            if (frameSize > maxFrameSize) {
+                state = State::Failed;
+                break;
+            }
+            state = State::Body;
+        }
+
+        if (buffer.size() < frameSize) {
+            // 본문 전체가 들어올 공간을 미리 확보해 두고 다음 수신을 기다림
+            buffer.reserve(frameSize - buffer.size());
+            break;
+        }
+
+        const char* body = buffer.contiguous(0, frameSize);
+        if (!body) {
+            scratch.resize(frameSize);
+            buffer.peek(0, &scratch[0], frameSize);
+            body = scratch.data();
+        }
+
+        state = State::Header;
+        ++frames;
+        bool keepGoing = onFrame(body, frameSize);
+        buffer.consume(frameSize);
+        if (!keepGoing) {
+            break;
+        }
+    }
+
+    return frames;
+}
+
+size_t FrameDecoder::decode(RingBuffer& buffer, const FrameHandler& onFrame) {
+    return decodeFrames(buffer, onFrame);
+}
+
+size_t FrameDecoder::decode(SharedRing& buffer, const FrameHandler& onFrame) {
+    return decodeFrames(buffer, onFrame);
+}
@@ -1,11 +1,23 @@
 #include "GameManager.hpp"
 #include <iostream>
 #include <algorithm>
+#include <ctime>
+#include <fstream>
 #include <random>
 
+// 조각 위치 [y, x]를 전송용 배열로 변환
+static MessageData toPositionData(const vector<int>& pos) {
+    MessageData position = MessageData::array();
+    for (int value : pos) {
+        position.push_back(value);
+    }
+    return position;
+}
+
 GameManager::GameManager(EventBus& bus) : 
     gameStarted(false),
-    eventBus(bus) {
+    eventBus(bus),
+    seedGenerator(std::random_device{}()) {
     setupEventHandlers();
 }
 
@@ -26,28 +38,75 @@ void GameManager::setupEventHandlers() {
     
     // 클라이언트 메시지 수신 이벤트 구독
     eventBus.subscribe("client_message_received", [this](const Event& event) {
-        std::string type = event.data["type"].stringValue;
+        handleInput(event.data);
+    });
+    
+    // 네트워크 계층이 수신한 메시지 묶음을 모두 처리한 뒤 바뀐 상태를 전송
+    eventBus.subscribe("client_messages_processed", [this](const Event&) {
+        flushStateChanges();
+    });
+
+    // 송신 큐 혼잡 이벤트 구독 (네트워크 계층의 백프레셔)
+    eventBus.subscribe("client_backpressure", [this](const Event& event) {
         int playerId = event.data["player_id"].intValue;
-        
-        if (type == "move_left") {
-            handleMove(playerId, -1);
-        }
-        else if (type == "move_right") {
-            handleMove(playerId, 1);
-        }
-        else if (type == "rotate") {
-            handleRotate(playerId);
-        }
-        else if (type == "move_down") {
-            handleMoveDown(playerId);
+        bool congested = event.data["congested"].boolValue;
+
+        if (congested) {
+            congestedPlayers.insert(playerId);
+        } else {
+            congestedPlayers.erase(playerId);
+            // 밀려 있던 동안 건너뛴 상태 대신 최신 상태를 한 번 전송
+            if (players.find(playerId) != players.end()) {
+                publishPlayerState(playerId);
+            }
         }
-        else if (type == "hard_drop") {
-            handleHardDrop(playerId);
+    });
+    
+    // 연결이 끊겨 재연결을 기다리는 동안은 상태를 보관만 하고 전송하지 않음
+    eventBus.subscribe("client_suspended", [this](const Event& event) {
+        int playerId = event.data["player_id"].intValue;
+        suspendedPlayers.insert(playerId);
+        changedPlayers.erase(playerId);
+        ackedPlayers.erase(playerId);
+    });
+
+    // 재연결한 클라이언트에게 전체 상태 대신 변경분 전송
+    eventBus.subscribe("client_resumed", [this](const Event& event) {
+        int playerId = event.data["player_id"].intValue;
+        suspendedPlayers.erase(playerId);
+        // 새 연결의 송신 큐는 비어 있으므로 이전 연결의 혼잡 상태는 버림
+        congestedPlayers.erase(playerId);
+        if (players.find(playerId) != players.end()) {
+            publishResumeState(playerId, event.data["last_state_seq"].intValue);
         }
-        else {
-            std::cout << "알 수 없는 메시지 타입: " << type << std::endl;
+    });
+    
+    // connect에서 고른 방 기록
+    eventBus.subscribe("player_connect", [this](const Event& event) {
+        if (event.data.contains("room")) {
+            playerRooms[event.data["player_id"].intValue] = event.data["room"].stringValue;
         }
     });
+
+    // 방 이동: 원래 프로세스에서 방을 멈추고 스냅샷을 뜸 → 대상 프로세스에서 복원
+    // (이동을 취소하면 원래 프로세스에서 다시 진행)
+    eventBus.subscribe("room_export", [this](const Event& event) {
+        exportRoom(event.data);
+    });
+    eventBus.subscribe("room_restore", [this](const Event& event) {
+        restoreRoom(event.data);
+    });
+    eventBus.subscribe("room_resume", [this](const Event& event) {
+        pausedRooms.erase(event.data["room"].stringValue);
+    });
+
+    // 무중단 재시작: 이전 프로세스가 전체 게임 상태를 떠서 후임 프로세스에 넘김
+    eventBus.subscribe("game_snapshot_request", [this](const Event&) {
+        eventBus.publish("game_snapshot", exportGame());
+    });
+    eventBus.subscribe("game_restore", [this](const Event& event) {
+        restoreGame(event.data);
+    });
     
     // 게임 상태 요청 이벤트 구독
     eventBus.subscribe("request_game_state", [this](const Event& event) {
@@ -63,7 +122,7 @@ void GameManager::setupEventHandlers() {
             MessageData playerData;
             for (const auto& [id, player] : players) {
                 MessageData playerInfo;
-                playerInfo["socket"] = player.getPlayerSocket(id);
+                playerInfo["socket"] = player.socket;
                 playerData[std::to_string(id)] = playerInfo;
             }
             
@@ -83,7 +142,7 @@ void GameManager::setupEventHandlers() {
                 MessageData response;
                 response["action"] = "player_socket_info";
                 response["player_id"] = playerId;
-                response["socket"] = players[playerId].getPlayerSocket(playerId);
+                response["socket"] = players[playerId].socket;
                 
                 if (event.data.contains("message")) {
                     response["message"] = event.data["message"];
@@ -95,17 +154,82 @@ void GameManager::setupEventHandlers() {
     });
 }
 
+void GameManager::handleInput(const MessageData& input) {
+    std::string type = input["type"].stringValue;
+    int playerId = input["player_id"].intValue;
+
+    // 다른 프로세스로 옮기는 중인 방은 스냅샷 이후의 입력을 반영하지 않음
+    auto room = playerRooms.find(playerId);
+    if (room != playerRooms.end() && pausedRooms.count(room->second)) {
+        return;
+    }
+
+    // 시퀀스 번호가 있는 입력은 한 번만 처리 (재연결 후 응답을 받지 못한 입력을 다시 보내는 경우)
+    int64_t inputSeq = input.contains("seq") ? input["seq"].intValue : 0;
+    if (inputSeq > 0) {
+        int64_t& lastSeq = lastInputSeq[playerId];
+        if (inputSeq <= lastSeq) {
+            return;
+        }
+        lastSeq = inputSeq;
+    }
+
+    bool wasChanged = changedPlayers.count(playerId) > 0;
+    bool moved = false;
+
+    if (type == "move_left") {
+        moved = handleMove(playerId, -1);
+    }
+    else if (type == "move_right") {
+        moved = handleMove(playerId, 1);
+    }
+    else if (type == "rotate") {
+        moved = handleRotate(playerId);
+    }
+    else if (type == "move_down") {
+        moved = handleMoveDown(playerId);
+    }
+    else if (type == "hard_drop") {
+        handleHardDrop(playerId);
+    }
+    else {
+        std::cout << "알 수 없는 메시지 타입: " << type << std::endl;
+    }
+
+    if (inputSeq <= 0) {
+        return;
+    }
+
+    // 클라이언트가 예측한 위치(expect_y, expect_x)와 결과가 같으면 이미 화면에 그린 상태이므로
+    // 전체 상태 대신 처리한 입력 번호만 알림 (다르면 전체 상태가 보정값이 됨)
+    if (moved && !wasChanged && input.contains("expect_y") && input.contains("expect_x")) {
+        const vector<int>& pos = players[playerId].currentPos;
+        if (input["expect_y"].intValue == pos[0] && input["expect_x"].intValue == pos[1]) {
+            changedPlayers.erase(playerId);
+        }
+    }
+    if (!changedPlayers.count(playerId)) {
+        ackedPlayers.insert(playerId);
+    }
+}
+
 void GameManager::addPlayer(int playerId, int socket) {
-    // PlayerInfo 객체 생성 및 초기화
-    players.emplace(std::piecewise_construct,
-                   std::forward_as_tuple(playerId),
-                   std::forward_as_tuple(eventBus));
-    
-    // 플레이어 정보 설정
-    players[playerId].addPlayer(playerId, socket);
+    // client_connected를 여러 곳에서 받으므로 이미 추가된 플레이어는 무시
+    if (players.find(playerId) != players.end()) {
+        return;
+    }
+
+    // 플레이어별 상태만 담는 PlayerInfo (이벤트 구독 없는 기본 생성자 사용)
+    PlayerInfo& player = players[playerId];
+    player.socket = socket;
+    player.pieceSeed = seedGenerator();
+    player.pieceGenerator.seed(player.pieceSeed);
     
     // 새 조각 생성
-    auto [piece, blockType] = generateNewPiece();
+    auto [piece, blockType] = generateNewPiece(player);
+    player.currentPiece["shape"] = piece["shape"];
+    player.currentPiece["block_type"] = blockType;
+    player.currentBlockType = blockType;
     
     // 플레이어 추가 완료 이벤트 발행
     MessageData playerAddedData;
@@ -115,6 +239,13 @@ void GameManager::addPlayer(int playerId, int socket) {
 
 void GameManager::removePlayer(int playerId) {
     players.erase(playerId);
+    congestedPlayers.erase(playerId);
+    changedPlayers.erase(playerId);
+    suspendedPlayers.erase(playerId);
+    ackedPlayers.erase(playerId);
+    stateHistory.erase(playerId);
+    lastInputSeq.erase(playerId);
+    playerRooms.erase(playerId);
     
     // 플레이어 제거 완료 이벤트 발행
     MessageData playerRemovedData;
@@ -124,9 +255,9 @@ void GameManager::removePlayer(int playerId) {
 
 void GameManager::handleNewPiece(int playerId) {
     auto& player = players[playerId];
-    auto [piece, blockType] = generateNewPiece();
+    auto [piece, blockType] = generateNewPiece(player);
     player.currentPiece = MessageData();  // 빈 객체로 초기화
-    player.currentPiece["shape"] = piece;
+    player.currentPiece["shape"] = piece["shape"];
     player.currentPiece["block_type"] = blockType;
     player.currentBlockType = blockType;
     
@@ -142,36 +273,139 @@ void GameManager::handleNewPiece(int playerId) {
         eventBus.publish("game_over", gameOverData);
     }
 
-    // 게임 상태 변경 시 이벤트 발행
+    // 게임 상태 변경 표시 (처리 단계가 끝나면 한 번에 전송)
+    markStateChanged(playerId);
+}
+
+void GameManager::markStateChanged(int playerId) {
+    changedPlayers.insert(playerId);
+}
+
+void GameManager::flushStateChanges() {
+    // 한 처리 단계에서 여러 번 바뀐 상태도 플레이어당 한 번만 직렬화/전송
+    set<int> changed;
+    changed.swap(changedPlayers);
+    for (int playerId : changed) {
+        if (players.find(playerId) != players.end()) {
+            publishPlayerState(playerId);
+        }
+    }
+
+    // 예측대로 처리된 입력만 있었던 플레이어에게는 입력 번호만 전송 (상태 전송에는 이미 포함됨)
+    set<int> acked;
+    acked.swap(ackedPlayers);
+    for (int playerId : acked) {
+        if (changed.count(playerId) || congestedPlayers.count(playerId) || suspendedPlayers.count(playerId) ||
+            players.find(playerId) == players.end()) {
+            continue;
+        }
+        MessageData ack;
+        ack["type"] = "input_ack";
+        ack["player_id"] = playerId;
+        ack["input_seq"] = lastInputSeq[playerId];
+        eventBus.publish("game_state_changed", ack);
+    }
+}
+
+void GameManager::publishPlayerState(int playerId) {
+    // 송신 큐가 밀린 플레이어에게는 중간 상태를 보내지 않음 (혼잡 해소 시 최신 상태 전송)
+    // 재연결을 기다리는 플레이어도 보낼 연결이 없으므로 건너뜀 (재연결 시 변경분 전송)
+    if (congestedPlayers.count(playerId) || suspendedPlayers.count(playerId)) {
+        return;
+    }
+
+    auto& player = players[playerId];
+    recordState(playerId, player);
+
     MessageData gameStateData;
+    gameStateData["type"] = "player_state";
     gameStateData["board"] = player.board;
     gameStateData["score"] = player.score;
     gameStateData["current_piece"] = player.currentPiece;
+    gameStateData["position"] = toPositionData(player.currentPos);
     gameStateData["player_id"] = playerId;
+    gameStateData["state_seq"] = stateHistory[playerId].seq;
+    gameStateData["input_seq"] = lastInputSeq[playerId];
     eventBus.publish("game_state_changed", gameStateData);
 }
 
-void GameManager::handleMove(int playerId, int direction) {
+void GameManager::recordState(int playerId, const PlayerInfo& player) {
+    // 새 상태 번호를 매기고, 지난 전송 이후 바뀐 칸에 그 번호를 기록
+    StateHistory& history = stateHistory[playerId];
+    history.seq++;
+
+    if (history.board.empty()) {
+        history.board = player.board;
+        history.cellSeq.assign(GRID_HEIGHT, vector<int64_t>(GRID_WIDTH, history.seq));
+        return;
+    }
+
+    for (int y = 0; y < GRID_HEIGHT; y++) {
+        for (int x = 0; x < GRID_WIDTH; x++) {
+            if (history.board[y][x] != player.board[y][x]) {
+                history.board[y][x] = player.board[y][x];
+                history.cellSeq[y][x] = history.seq;
+            }
+        }
+    }
+}
+
+void GameManager::publishResumeState(int playerId, int64_t lastStateSeq) {
+    auto& player = players[playerId];
+    StateHistory& history = stateHistory[playerId];
+
+    // 기준 상태를 알 수 없으면 (처음 연결 직후 끊겼거나 잘못된 번호) 전체 상태 전송
+    if (lastStateSeq <= 0 || lastStateSeq > history.seq || history.board.empty()) {
+        publishPlayerState(playerId);
+        return;
+    }
+
+    // 끊겨 있는 동안 바뀐 상태까지 반영한 뒤, 기준 상태 이후에 바뀐 칸만 [y, x, 값]으로 전송
+    recordState(playerId, player);
+
+    vector<vector<int>> cells;
+    for (int y = 0; y < GRID_HEIGHT; y++) {
+        for (int x = 0; x < GRID_WIDTH; x++) {
+            if (history.cellSeq[y][x] > lastStateSeq) {
+                cells.push_back({y, x, history.board[y][x]});
+            }
+        }
+    }
+
+    MessageData delta;
+    delta["type"] = "game_state_delta";
+    delta["player_id"] = playerId;
+    delta["base_seq"] = lastStateSeq;
+    delta["state_seq"] = history.seq;
+    delta["cells"] = cells;
+    delta["score"] = player.score;
+    delta["current_piece"] = player.currentPiece;
+    delta["position"] = toPositionData(player.currentPos);
+    delta["input_seq"] = lastInputSeq[playerId];
+    eventBus.publish("game_state_changed", delta);
+
+    std::cout << "플레이어 " << playerId << " 재연결 변경분 전송: 상태 " << lastStateSeq << " → "
+              << history.seq << ", 칸 " << cells.size() << "개" << std::endl;
+}
+
+bool GameManager::handleMove(int playerId, int direction) {
     auto& player = players[playerId];
     vector<int> newPos = {
         player.currentPos[0],
         player.currentPos[1] + direction
     };
     
-    if (isValidMove(player.board, player.currentPiece, newPos)) {
+    bool moved = isValidMove(player.board, player.currentPiece, newPos);
+    if (moved) {
         player.currentPos = newPos;
     }
 
-    // 게임 상태 변경 시 이벤트 발행
-    MessageData gameStateData;
-    gameStateData["board"] = player.board;
-    gameStateData["score"] = player.score;
-    gameStateData["current_piece"] = player.currentPiece;
-    gameStateData["player_id"] = playerId;
-    eventBus.publish("game_state_changed", gameStateData);
+    // 게임 상태 변경 표시 (처리 단계가 끝나면 한 번에 전송)
+    markStateChanged(playerId);
+    return moved;
 }
 
-void GameManager::handleRotate(int playerId) {
+bool GameManager::handleRotate(int playerId) {
     auto& player = players[playerId];
     MessageData rotatedShape = rotatePiece(player.currentPiece["shape"]);
     
@@ -179,17 +413,14 @@ void GameManager::handleRotate(int playerId) {
     rotatedPiece["shape"] = rotatedShape;
     rotatedPiece["block_type"] = player.currentBlockType;
     
-    if (isValidMove(player.board, rotatedPiece, player.currentPos)) {
+    bool rotated = isValidMove(player.board, rotatedPiece, player.currentPos);
+    if (rotated) {
         player.currentPiece = rotatedPiece;
     }
 
-    // 게임 상태 변경 시 이벤트 발행
-    MessageData gameStateData;
-    gameStateData["board"] = player.board;
-    gameStateData["score"] = player.score;
-    gameStateData["current_piece"] = player.currentPiece;
-    gameStateData["player_id"] = playerId;
-    eventBus.publish("game_state_changed", gameStateData);
+    // 게임 상태 변경 표시 (처리 단계가 끝나면 한 번에 전송)
+    markStateChanged(playerId);
+    return rotated;
 }
 
 bool GameManager::isValidMove(const vector<vector<int>>& board, const MessageData& piece, const vector<int>& pos) {
@@ -211,7 +442,7 @@ bool GameManager::isValidMove(const vector<vector<int>>& board, const MessageDat
     return true;
 }
 
-std::pair<MessageData, int> GameManager::generateNewPiece() {
+std::pair<MessageData, int> GameManager::generateNewPiece(PlayerInfo& player) {
     static const std::vector<std::vector<std::vector<int>>> PIECES = {
         // I
         {
@@ -249,11 +480,9 @@ std::pair<MessageData, int> GameManager::generateNewPiece() {
         }
     };
     
-    // 랜덤 조각 선택
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, PIECES.size() - 1);
-    int blockType = dis(gen);
+    // 랜덤 조각 선택 (조각마다 생성기를 정확히 한 번 호출해야 뽑은 횟수로 상태를 되살릴 수 있음)
+    int blockType = player.pieceGenerator() % PIECES.size();
+    player.piecesDrawn++;
     
     // MessageData 객체 생성
     MessageData piece;
@@ -294,6 +523,159 @@ MessageData GameManager::getGameState() const {
     return state;
 }
 
+MessageData GameManager::exportPlayer(int playerId) {
+    const PlayerInfo& player = players.at(playerId);
+    auto inputSeq = lastInputSeq.find(playerId);
+
+    MessageData state;
+    state["board"] = player.board;
+    state["current_piece"] = player.currentPiece;
+    state["position"] = toPositionData(player.currentPos);
+    state["block_type"] = player.currentBlockType;
+    state["score"] = player.score;
+    state["piece_seed"] = static_cast<int64_t>(player.pieceSeed);
+    state["pieces_drawn"] = static_cast<int64_t>(player.piecesDrawn);
+    state["input_seq"] = inputSeq != lastInputSeq.end() ? inputSeq->second : int64_t(0);
+    auto history = stateHistory.find(playerId);
+    state["state_seq"] = history != stateHistory.end() ? history->second.seq : int64_t(0);
+    return state;
+}
+
+void GameManager::importPlayer(int playerId, const MessageData& state) {
+    PlayerInfo& player = players[playerId];
+
+    const MessageData& board = state["board"];
+    for (int y = 0; y < GRID_HEIGHT && y < static_cast<int>(board.size()); y++) {
+        for (int x = 0; x < GRID_WIDTH && x < static_cast<int>(board[y].size()); x++) {
+            player.board[y][x] = static_cast<int>(board[y][x].intValue);
+        }
+    }
+    player.currentPiece = state["current_piece"];
+    player.currentPos = {static_cast<int>(state["position"][0].intValue), static_cast<int>(state["position"][1].intValue)};
+    player.currentBlockType = static_cast<int>(state["block_type"].intValue);
+    player.score = static_cast<int>(state["score"].intValue);
+
+    // 같은 시드로 만든 뒤 이미 뽑은 만큼 건너뛰어 다음 조각 순서를 그대로 이어 감
+    player.pieceSeed = static_cast<uint32_t>(state["piece_seed"].intValue);
+    player.piecesDrawn = static_cast<uint64_t>(state["pieces_drawn"].intValue);
+    player.pieceGenerator.seed(player.pieceSeed);
+    player.pieceGenerator.discard(player.piecesDrawn);
+
+    if (state["input_seq"].intValue > 0) {
+        lastInputSeq[playerId] = state["input_seq"].intValue;
+    }
+
+    // 상태 번호를 이어 가되 칸별 기록은 없으므로 이전 번호로 resume하면 모든 칸을 다시 보냄
+    if (state.contains("state_seq") && state["state_seq"].intValue > 0) {
+        StateHistory& history = stateHistory[playerId];
+        history.seq = state["state_seq"].intValue;
+        history.board = player.board;
+        history.cellSeq.assign(GRID_HEIGHT, vector<int64_t>(GRID_WIDTH, history.seq));
+    }
+}
+
+void GameManager::exportRoom(const MessageData& request) {
+    std::string room = request["room"].stringValue;
+    pausedRooms.insert(room);
+
+    // 플레이어 ID는 프로세스마다 따로 할당하므로 대상 프로세스는 새 ID로 복원하고 원래 ID로 짝을 맞춤
+    MessageData roomPlayers;
+    roomPlayers.type = MessageData::Object;
+    for (const auto& [playerId, playerRoom] : playerRooms) {
+        if (playerRoom == room && players.find(playerId) != players.end()) {
+            roomPlayers[std::to_string(playerId)] = exportPlayer(playerId);
+        }
+    }
+
+    MessageData snapshot;
+    snapshot["room"] = room;
+    snapshot["players"] = roomPlayers;
+
+    MessageData response;
+    response["type"] = "room_snapshot";
+    response["player_id"] = request["reply_to"].intValue;
+    response["room"] = room;
+    response["players"] = static_cast<int64_t>(roomPlayers.size());
+    response["snapshot"] = snapshot.serialize();
+    std::cout << "방 " << room << " 정지, 스냅샷 " << roomPlayers.size() << "명 (" << response["snapshot"].size()
+              << " 바이트)" << std::endl;
+    eventBus.publish("room_snapshot", response);
+}
+
+void GameManager::restoreRoom(const MessageData& data) {
+    std::string room = data["room"].stringValue;
+    for (const auto& [id, state] : data["players"].objectValue) {
+        int playerId = std::stoi(id);
+        importPlayer(playerId, state);
+        playerRooms[playerId] = room;
+        // 클라이언트가 resume할 때까지는 보낼 연결이 없음 (resume하면 전체 상태 전송)
+        suspendedPlayers.insert(playerId);
+    }
+    pausedRooms.erase(room);
+    std::cout << "방 " << room << " 복원: " << data["players"].size() << "명" << std::endl;
+}
+
+MessageData GameManager::exportGame() {
+    MessageData playersData;
+    playersData.type = MessageData::Object;
+    for (const auto& [playerId, player] : players) {
+        MessageData state = exportPlayer(playerId);
+        auto room = playerRooms.find(playerId);
+        if (room != playerRooms.end()) {
+            state["room"] = room->second;
+        }
+        state["suspended"] = suspendedPlayers.count(playerId) > 0;
+        playersData[std::to_string(playerId)] = state;
+    }
+
+    MessageData paused;
+    paused.type = MessageData::Object;
+    for (const std::string& room : pausedRooms) {
+        paused[room] = true;
+    }
+
+    MessageData snapshot;
+    snapshot["players"] = playersData;
+    snapshot["paused_rooms"] = paused;
+    snapshot["game_started"] = gameStarted;
+    return snapshot;
+}
+
+void GameManager::restoreGame(const MessageData& snapshot) {
+    for (const auto& [id, state] : snapshot["players"].objectValue) {
+        int playerId = std::stoi(id);
+        importPlayer(playerId, state);
+        if (state.contains("room")) {
+            playerRooms[playerId] = state["room"].stringValue;
+        }
+        if (state["suspended"].boolValue) {
+            suspendedPlayers.insert(playerId);
+        }
+    }
+    for (const auto& [room, paused] : snapshot["paused_rooms"].objectValue) {
+        pausedRooms.insert(room);
+    }
+    gameStarted = snapshot["game_started"].boolValue;
+    std::cout << "이전 프로세스의 게임 상태 복원: 플레이어 " << snapshot["players"].size() << "명" << std::endl;
+}
+
+void GameManager::saveResults(const std::string& path) const {
+    std::ofstream out(path, std::ios::app);
+    if (!out) {
+        std::cerr << "게임 결과 기록 실패: " << path << std::endl;
+        return;
+    }
+
+    long long now = static_cast<long long>(std::time(nullptr));
+    for (const auto& [playerId, player] : players) {
+        auto room = playerRooms.find(playerId);
+        out << now << '\t' << playerId << '\t' << player.score << '\t'
+            << (room != playerRooms.end() ? room->second : "") << '\n';
+    }
+    out.flush();
+    std::cout << "게임 결과 기록: 플레이어 " << players.size() << "명 → " << path << std::endl;
+}
+
 PlayerInfo& GameManager::getPlayer(int playerId) {
     return players.at(playerId);
 }
@@ -329,13 +711,8 @@ void GameManager::freezePiece(int playerId) {
     }
     checkLines(playerId);
 
-    // 게임 상태 변경 시 이벤트 발행
-    MessageData gameStateData;
-    gameStateData["board"] = player.board;
-    gameStateData["score"] = player.score;
-    gameStateData["current_piece"] = player.currentPiece;
-    gameStateData["player_id"] = playerId;
-    eventBus.publish("game_state_changed", gameStateData);
+    // 게임 상태 변경 표시 (처리 단계가 끝나면 한 번에 전송)
+    markStateChanged(playerId);
 }
 
 void GameManager::checkLines(int playerId) {
@@ -365,16 +742,11 @@ void GameManager::checkLines(int playerId) {
         player.score += lines_to_clear.size() * 100;
     }
 
-    // 게임 상태 변경 시 이벤트 발행
-    MessageData gameStateData;
-    gameStateData["board"] = player.board;
-    gameStateData["score"] = player.score;
-    gameStateData["current_piece"] = player.currentPiece;
-    gameStateData["player_id"] = playerId;
-    eventBus.publish("game_state_changed", gameStateData);
+    // 게임 상태 변경 표시 (처리 단계가 끝나면 한 번에 전송)
+    markStateChanged(playerId);
 }
 
-void GameManager::handleMoveDown(int playerId) {
+bool GameManager::handleMoveDown(int playerId) {
     auto& player = players[playerId];
     vector<int> newPos = {
         player.currentPos[0] + 1,  // y 좌표 증가
@@ -383,9 +755,13 @@ void GameManager::handleMoveDown(int playerId) {
     
     if (isValidMove(player.board, player.currentPiece, newPos)) {
         player.currentPos = newPos;
-    } else {
-        // 더 이상 내려갈 수 없으면 블록을 고정하고 새 블록 생성
-        freezePiece(playerId);
-        handleNewPiece(playerId);
+        // 게임 상태 변경 표시 (처리 단계가 끝나면 한 번에 전송)
+        markStateChanged(playerId);
+        return true;
     }
+
+    // 더 이상 내려갈 수 없으면 블록을 고정하고 새 블록 생성
+    freezePiece(playerId);
+    handleNewPiece(playerId);
+    return false;
 } 
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include "GatewayBridge.hpp"
+#include "SimulationProtocol.hpp"
+#include <iostream>
+
+// 시뮬레이션 프로세스의 GameManager가 구독하는 입력 이벤트
+static const char* const FORWARDED_EVENTS[] = {
+    "client_connected",
+    "client_disconnected",
+    "client_message_received",
+    "client_messages_processed",
+    "client_backpressure",
+    "client_suspended",
+    "client_resumed",
+    "request_game_state",
+};
+
+GatewayBridge::GatewayBridge(const ServerConfig& config, EventBus& bus, NetworkManager& network) :
+    eventBus(bus),
+    networkManager(network) {
+    for (const std::string& path : config.simulationPaths) {
+        int socket = ProcessLink::connectUnix(path);
+        simulations.push_back(Simulation{path, std::make_unique<ProcessLink>(
+            socket, SimulationProtocol::MAX_RECORD_SIZE, SimulationProtocol::MAX_QUEUED_BYTES)});
+        std::cout << "시뮬레이션 프로세스 연결: " << path << std::endl;
+    }
+
+    // 링크 스레드가 레코드를 넘기기 시작하기 전에 목록을 다 채워 둠 (이후 목록은 바뀌지 않음)
+    for (size_t i = 0; i < simulations.size(); ++i) {
+        simulations[i].link->start(
+            [this, i](const char* data, size_t length) {
+                handleRecord(i, data, length);
+            },
+            [this, i]() {
+                handleLinkClosed(i);
+            });
+    }
+
+    setupEventHandlers();
+}
+
+GatewayBridge::~GatewayBridge() {
+    {
+        std::lock_guard<std::mutex> lock(assignmentMutex);
+        closing = true;
+    }
+    // 링크 스레드를 먼저 멈춰 해제 중인 객체로 프레임이 들어오지 않게 함
+    for (Simulation& simulation : simulations) {
+        simulation.link->close();
+    }
+    simulations.clear();
+}
+
+void GatewayBridge::setupEventHandlers() {
+    for (const char* name : FORWARDED_EVENTS) {
+        std::string eventName = name;
+        eventBus.subscribe(eventName, [this, eventName](const Event& event) {
+            forward(eventName, event.data);
+        });
+    }
+}
+
+void GatewayBridge::forward(const std::string& name, const MessageData& data) {
+    std::string record = SimulationProtocol::encodeEvent(name, data);
+
+    // 특정 플레이어가 없는 이벤트(UDP 입력 묶음 처리 완료 등)는 모든 시뮬레이션에 전달
+    if (!data.contains("player_id")) {
+        for (Simulation& simulation : simulations) {
+            simulation.link->send(record);
+        }
+        return;
+    }
+
+    int playerId = data["player_id"].intValue;
+    size_t index = simulations.size();
+    {
+        std::lock_guard<std::mutex> lock(assignmentMutex);
+        auto it = playerSimulations.find(playerId);
+        if (it == playerSimulations.end()) {
+            // 링크를 잃어 이미 정리한 플레이어의 연결 종료는 전달할 곳이 없음
+            if (name == "client_disconnected") {
+                return;
+            }
+            // 처음 보는 플레이어는 ID로 고르게 배정 (재연결해도 ID가 같으므로 같은 시뮬레이션으로 감)
+            // 그 시뮬레이션을 잃었으면 살아 있는 다음 시뮬레이션으로
+            for (size_t offset = 0; offset < simulations.size(); ++offset) {
+                size_t candidate = (playerId + offset) % simulations.size();
+                if (!simulations[candidate].lost) {
+                    it = playerSimulations.emplace(playerId, candidate).first;
+                    break;
+                }
+            }
+        }
+        if (it != playerSimulations.end()) {
+            index = it->second;
+            if (name == "client_disconnected") {
+                playerSimulations.erase(it);
+            }
+        }
+    }
+
+    // 시뮬레이션이 모두 끊겨 게임을 진행할 곳이 없음
+    if (index == simulations.size()) {
+        std::cerr << "살아 있는 시뮬레이션 프로세스 없음, 플레이어 " << playerId << " 연결 종료" << std::endl;
+        networkManager.disconnectPlayer(playerId);
+        return;
+    }
+
+    if (!simulations[index].link->send(record)) {
+        std::cerr << "시뮬레이션 프로세스로 이벤트 전달 실패: " << name << " (플레이어 " << playerId << ")" << std::endl;
+    }
+}
+
+void GatewayBridge::handleRecord(size_t simulation, const char* data, size_t length) {
+    if (SimulationProtocol::recordType(data, length) != SimulationProtocol::FRAME_RECORD) {
+        std::cerr << "시뮬레이션 프로세스에서 알 수 없는 레코드 수신 (" << length << " 바이트)" << std::endl;
+        return;
+    }
+
+    int playerId;
+    const char* frameData;
+    size_t frameLength;
+    if (!SimulationProtocol::decodeFrame(data, length, playerId, frameData, frameLength)) {
+        return;
+    }
+    FramePtr frame = makeFrame(std::string(frameData, frameLength));
+
+    if (playerId != SimulationProtocol::BROADCAST) {
+        networkManager.sendFrame(playerId, frame);
+        return;
+    }
+
+    // 시뮬레이션이 하나면 전체 연결에, 여럿이면 그 시뮬레이션에 배정된 플레이어에게만 전송
+    if (simulations.size() == 1) {
+        networkManager.broadcastFrame(frame);
+        return;
+    }
+    std::vector<int> players;
+    {
+        std::lock_guard<std::mutex> lock(assignmentMutex);
+        for (const auto& [id, index] : playerSimulations) {
+            if (index == simulation) {
+                players.push_back(id);
+            }
+        }
+    }
+    for (int id : players) {
+        networkManager.sendFrame(id, frame);
+    }
+}
+
+void GatewayBridge::handleLinkClosed(size_t simulation) {
+    // 시뮬레이션과 함께 게임 상태도 사라졌으므로 배정된 플레이어는 연결을 끊어 새로 접속하게 함
+    // (다시 접속하면 새 ID로 살아 있는 시뮬레이션에 배정됨)
+    std::vector<int> players;
+    {
+        std::lock_guard<std::mutex> lock(assignmentMutex);
+        if (closing) {
+            return;
+        }
+        simulations[simulation].lost = true;
+        for (auto it = playerSimulations.begin(); it != playerSimulations.end();) {
+            if (it->second == simulation) {
+                players.push_back(it->first);
+                it = playerSimulations.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    std::cerr << "시뮬레이션 프로세스 연결 끊김: " << simulations[simulation].path << ", 플레이어 " << players.size()
+              << "명 연결 종료" << std::endl;
+    for (int playerId : players) {
+        networkManager.disconnectPlayer(playerId);
+    }
+}
@@ -0,0 +1,170 @@
+#include "HotRestart.hpp"
+#include <sys/socket.h>
+#include <poll.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <iostream>
+#include <string.h>
+
+static bool writeAll(int socket, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t sent = ::send(socket, data, length, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent <= 0) {
+            return false;
+        }
+        data += sent;
+        length -= sent;
+    }
+    return true;
+}
+
+static bool readAll(int socket, char* data, size_t length) {
+    while (length > 0) {
+        ssize_t received = recv(socket, data, length, 0);
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            return false;
+        }
+        data += received;
+        length -= received;
+    }
+    return true;
+}
+
+static void writeUint32(char* out, uint32_t value) {
+    out[0] = static_cast<char>((value >> 24) & 0xFF);
+    out[1] = static_cast<char>((value >> 16) & 0xFF);
+    out[2] = static_cast<char>((value >> 8) & 0xFF);
+    out[3] = static_cast<char>(value & 0xFF);
+}
+
+static uint32_t readUint32(const char* in) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(in);
+    return (static_cast<uint32_t>(bytes[0]) << 24) | (static_cast<uint32_t>(bytes[1]) << 16) |
+           (static_cast<uint32_t>(bytes[2]) << 8) | bytes[3];
+}
+
+bool HotRestart::send(int socket, const MessageData& state, const std::vector<int>& fds) {
+    std::string record(4, 0);
+    state.serializeTo(record);
+    writeUint32(&record[0], static_cast<uint32_t>(record.size() - 4));
+    char count[4];
+    writeUint32(count, static_cast<uint32_t>(fds.size()));
+    if (record.size() - 4 > MAX_STATE_SIZE || !writeAll(socket, record.data(), record.size()) ||
+        !writeAll(socket, count, sizeof(count))) {
+        std::cerr << "재시작 상태 전송 실패: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    // 보조 데이터는 그 메시지의 바이트와 함께 도착하므로 묶음마다 1바이트씩 실어 보냄
+    alignas(cmsghdr) char control[CMSG_SPACE(MAX_FDS_PER_MESSAGE * sizeof(int))];
+    for (size_t offset = 0; offset < fds.size(); offset += MAX_FDS_PER_MESSAGE) {
+        size_t batch = std::min(MAX_FDS_PER_MESSAGE, fds.size() - offset);
+        char marker = 'F';
+        iovec span{&marker, 1};
+        msghdr message{};
+        message.msg_iov = &span;
+        message.msg_iovlen = 1;
+        message.msg_control = control;
+        message.msg_controllen = CMSG_SPACE(batch * sizeof(int));
+
+        cmsghdr* header = CMSG_FIRSTHDR(&message);
+        header->cmsg_level = SOL_SOCKET;
+        header->cmsg_type = SCM_RIGHTS;
+        header->cmsg_len = CMSG_LEN(batch * sizeof(int));
+        memcpy(CMSG_DATA(header), fds.data() + offset, batch * sizeof(int));
+
+        ssize_t sent;
+        do {
+            sent = sendmsg(socket, &message, MSG_NOSIGNAL);
+        } while (sent < 0 && errno == EINTR);
+        if (sent != 1) {
+            std::cerr << "재시작 소켓 전달 실패: " << strerror(errno) << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool HotRestart::receive(int socket, MessageData& state, std::vector<int>& fds) {
+    char header[4];
+    if (!readAll(socket, header, sizeof(header))) {
+        std::cerr << "재시작 상태 수신 실패 (이전 프로세스가 연결을 끊음)" << std::endl;
+        return false;
+    }
+    uint32_t size = readUint32(header);
+    if (size == 0 || size > MAX_STATE_SIZE) {
+        std::cerr << "재시작 상태 크기 오류: " << size << std::endl;
+        return false;
+    }
+    std::string record(size, 0);
+    char count[4];
+    if (!readAll(socket, &record[0], size) || !readAll(socket, count, sizeof(count))) {
+        std::cerr << "재시작 상태 수신 실패 (이전 프로세스가 연결을 끊음)" << std::endl;
+        return false;
+    }
+    try {
+        state = MessageData::deserialize(record);
+    } catch (const std::exception& e) {
+        std::cerr << "재시작 상태 해석 실패: " << e.what() << std::endl;
+        return false;
+    }
+
+    size_t expected = readUint32(count);
+    fds.clear();
+    fds.reserve(expected);
+    alignas(cmsghdr) char control[CMSG_SPACE(MAX_FDS_PER_MESSAGE * sizeof(int))];
+    while (fds.size() < expected) {
+        char marker;
+        iovec span{&marker, 1};
+        msghdr message{};
+        message.msg_iov = &span;
+        message.msg_iovlen = 1;
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+
+        ssize_t received = recvmsg(socket, &message, MSG_CMSG_CLOEXEC);
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        cmsghdr* cmsg = received == 1 ? CMSG_FIRSTHDR(&message) : nullptr;
+        if (!cmsg || cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS ||
+            (message.msg_flags & MSG_CTRUNC)) {
+            std::cerr << "재시작 소켓 수신 실패 (" << fds.size() << "/" << expected << ")" << std::endl;
+            for (int fd : fds) {
+                close(fd);
+            }
+            fds.clear();
+            return false;
+        }
+        size_t batch = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        const int* receivedFds = reinterpret_cast<const int*>(CMSG_DATA(cmsg));
+        fds.insert(fds.end(), receivedFds, receivedFds + batch);
+    }
+    return true;
+}
+
+bool HotRestart::sendAck(int socket) {
+    char ack = ACK;
+    return writeAll(socket, &ack, 1);
+}
+
+bool HotRestart::waitAck(int socket, int timeoutMs) {
+    pollfd waiting{socket, POLLIN, 0};
+    int ready;
+    do {
+        ready = poll(&waiting, 1, timeoutMs);
+    } while (ready < 0 && errno == EINTR);
+    if (ready <= 0) {
+        std::cerr << "재시작 상대 프로세스 응답 시간 초과" << std::endl;
+        return false;
+    }
+    char ack = 0;
+    return readAll(socket, &ack, 1) && ack == ACK;
+}
@@ -0,0 +1,674 @@
+#include "IoUringBackend.hpp"
+#include <stdexcept>
+
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#endif
+
+// 멀티샷 recv와 제공 버퍼 링은 커널 헤더 6.0 이상에서 사용 가능
+#if defined(IORING_RECV_MULTISHOT) && defined(IORING_ACCEPT_MULTISHOT)
+
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+static int ioUringSetup(unsigned entries, io_uring_params* params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int ioUringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags,
+                        const void* arg, size_t argSize) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, arg, argSize));
+}
+
+static int ioUringRegister(int fd, unsigned opcode, const void* arg, unsigned count) {
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, count));
+}
+
+IoUringBackend::IoUringBackend(EventLoop& loop, const Callbacks& cb, size_t threshold) :
+    eventLoop(loop),
+    callbacks(cb),
+    zeroCopyThreshold(threshold),
+    sqRingPtr(MAP_FAILED),
+    sqRingSize(0),
+    cqRingPtr(MAP_FAILED),
+    cqRingSize(0),
+    sqes(nullptr),
+    sqesSize(0),
+    sqLocalTail(0),
+    bufferRing(nullptr),
+    bufferRingSize(0),
+    bufferBase(nullptr),
+    bufferRingTail(0),
+    nextGeneration(1) {
+
+#ifndef IORING_SEND_ZC_REPORT_USAGE
+    // SENDMSG_ZC 완료 알림 형식은 커널 헤더 6.2 이상에서 정의됨
+    zeroCopyThreshold = 0;
+#endif
+
+    io_uring_params params{};
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = RING_ENTRIES * 4;  // 멀티샷 완료가 몰려도 넘치지 않도록 여유 있게
+
+    ringFd = ioUringSetup(RING_ENTRIES, &params);
+    if (ringFd < 0) {
+        throw std::runtime_error("io_uring 생성 실패: " + std::string(strerror(errno)));
+    }
+
+    if (!(params.features & IORING_FEAT_EXT_ARG)) {
+        close(ringFd);
+        throw std::runtime_error("io_uring 미지원 커널: IORING_FEAT_EXT_ARG 필요");
+    }
+
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMmap) {
+        sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+    }
+
+    sqRingPtr = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                     ringFd, IORING_OFF_SQ_RING);
+    if (sqRingPtr == MAP_FAILED) {
+        close(ringFd);
+        throw std::runtime_error("io_uring SQ 링 매핑 실패");
+    }
+
+    if (singleMmap) {
+        cqRingPtr = sqRingPtr;
+    } else {
+        cqRingPtr = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         ringFd, IORING_OFF_CQ_RING);
+        if (cqRingPtr == MAP_FAILED) {
+            munmap(sqRingPtr, sqRingSize);
+            close(ringFd);
+            throw std::runtime_error("io_uring CQ 링 매핑 실패");
+        }
+    }
+
+    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqesPtr = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         ringFd, IORING_OFF_SQES);
+    if (sqesPtr == MAP_FAILED) {
+        if (!singleMmap) {
+            munmap(cqRingPtr, cqRingSize);
+        }
+        munmap(sqRingPtr, sqRingSize);
+        close(ringFd);
+        throw std::runtime_error("io_uring SQE 배열 매핑 실패");
+    }
+    sqes = static_cast<io_uring_sqe*>(sqesPtr);
+
+    char* sq = static_cast<char*>(sqRingPtr);
+    sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    sqEntries = params.sq_entries;
+    sqLocalTail = *sqTail;
+
+    char* cq = static_cast<char*>(cqRingPtr);
+    cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+    setupBufferRing();
+
+    // 타이머 등 EventLoop에 등록된 보조 fd 감시
+    submitPoll();
+}
+
+IoUringBackend::~IoUringBackend() {
+    close(ringFd);
+    if (bufferBase) {
+        munmap(bufferBase, static_cast<size_t>(BUFFER_COUNT) * BUFFER_SIZE);
+    }
+    if (bufferRing) {
+        munmap(bufferRing, bufferRingSize);
+    }
+    munmap(sqes, sqesSize);
+    if (cqRingPtr != sqRingPtr) {
+        munmap(cqRingPtr, cqRingSize);
+    }
+    munmap(sqRingPtr, sqRingSize);
+}
+
+void IoUringBackend::setupBufferRing() {
+    bufferRingSize = BUFFER_COUNT * sizeof(io_uring_buf);
+    void* ringPtr = mmap(nullptr, bufferRingSize, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    void* basePtr = mmap(nullptr, static_cast<size_t>(BUFFER_COUNT) * BUFFER_SIZE, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ringPtr == MAP_FAILED || basePtr == MAP_FAILED) {
+        throw std::runtime_error("io_uring 수신 버퍼 할당 실패");
+    }
+    bufferRing = static_cast<io_uring_buf_ring*>(ringPtr);
+    bufferBase = static_cast<char*>(basePtr);
+
+    io_uring_buf_reg reg{};
+    reg.ring_addr = reinterpret_cast<uint64_t>(bufferRing);
+    reg.ring_entries = BUFFER_COUNT;
+    reg.bgid = BUFFER_GROUP;
+    if (ioUringRegister(ringFd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+        throw std::runtime_error("io_uring 제공 버퍼 링 등록 실패: " + std::string(strerror(errno)));
+    }
+
+    for (unsigned i = 0; i < BUFFER_COUNT; ++i) {
+        recycleBuffer(static_cast<uint16_t>(i));
+    }
+}
+
+void IoUringBackend::recycleBuffer(uint16_t bufferId) {
+    // C++에서는 __DECLARE_FLEX_ARRAY가 bufs의 오프셋을 바꾸므로 링 메모리를 직접 io_uring_buf 배열로 다룸
+    // tail은 첫 항목의 resv 필드와 겹치므로 addr/len/bid만 기록
+    io_uring_buf* entries = reinterpret_cast<io_uring_buf*>(bufferRing);
+    io_uring_buf* buf = &entries[bufferRingTail & (BUFFER_COUNT - 1)];
+    buf->addr = reinterpret_cast<uint64_t>(bufferBase + static_cast<size_t>(bufferId) * BUFFER_SIZE);
+    buf->len = BUFFER_SIZE;
+    buf->bid = bufferId;
+    ++bufferRingTail;
+    __atomic_store_n(&entries[0].resv, bufferRingTail, __ATOMIC_RELEASE);
+}
+
+uint64_t IoUringBackend::makeUserData(Operation op, uint32_t generation, int fd) {
+    return (static_cast<uint64_t>(op) << 56) |
+           (static_cast<uint64_t>(generation & 0xFFFFFF) << 32) |
+           static_cast<uint32_t>(fd);
+}
+
+io_uring_sqe* IoUringBackend::getSqe() {
+    // SQ가 가득 차면 쌓인 SQE를 먼저 제출
+    if (sqLocalTail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) >= sqEntries) {
+        submit(0, 0);
+    }
+
+    unsigned index = sqLocalTail & *sqMask;
+    sqArray[index] = index;
+    ++sqLocalTail;
+
+    io_uring_sqe* sqe = &sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+}
+
+int IoUringBackend::submit(unsigned waitCount, int timeoutMs) {
+    unsigned toSubmit = sqLocalTail - *sqTail;
+    __atomic_store_n(sqTail, sqLocalTail, __ATOMIC_RELEASE);
+
+    unsigned flags = 0;
+    __kernel_timespec timeout{};
+    io_uring_getevents_arg arg{};
+    arg.sigmask_sz = _NSIG / 8;
+
+    if (waitCount > 0) {
+        flags |= IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+        if (timeoutMs >= 0) {
+            timeout.tv_sec = timeoutMs / 1000;
+            timeout.tv_nsec = static_cast<long long>(timeoutMs % 1000) * 1000000;
+            arg.ts = reinterpret_cast<uint64_t>(&timeout);
+        }
+    }
+
+    int result = ioUringEnter(ringFd, toSubmit, waitCount, flags,
+                              (flags & IORING_ENTER_EXT_ARG) ? &arg : nullptr,
+                              (flags & IORING_ENTER_EXT_ARG) ? sizeof(arg) : 0);
+    if (result < 0 && errno != EINTR && errno != ETIME && errno != EBUSY) {
+        std::cerr << "io_uring 제출 실패: " << strerror(errno) << std::endl;
+    }
+    return result;
+}
+
+void IoUringBackend::submitAccept(int listenSocket) {
+    io_uring_sqe* sqe = getSqe();
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = listenSocket;
+    sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+    sqe->accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+    sqe->user_data = makeUserData(OpAccept, 0, listenSocket);
+}
+
+void IoUringBackend::submitRecv(int fd, uint32_t generation) {
+    io_uring_sqe* sqe = getSqe();
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = fd;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = BUFFER_GROUP;
+    sqe->user_data = makeUserData(OpRecv, generation, fd);
+}
+
+void IoUringBackend::submitRecordRecv(Slot& slot) {
+    Connection& conn = *slot.conn;
+    conn.inbound.reserve(conn.maxRecordSize);
+
+    int spanCount = conn.inbound.writableSpans(slot.recvSpans);
+    slot.recvRequested = slot.recvSpans[0].iov_len + (spanCount > 1 ? slot.recvSpans[1].iov_len : 0);
+    slot.recvMessage = msghdr{};
+    slot.recvMessage.msg_iov = slot.recvSpans;
+    slot.recvMessage.msg_iovlen = spanCount;
+
+    // MSG_TRUNC: 레코드가 요청보다 크면 잘린 길이 대신 원래 길이를 돌려받음
+    io_uring_sqe* sqe = getSqe();
+    sqe->opcode = IORING_OP_RECVMSG;
+    sqe->fd = conn.socket;
+    sqe->addr = reinterpret_cast<uint64_t>(&slot.recvMessage);
+    sqe->len = 1;
+    sqe->msg_flags = MSG_TRUNC;
+    sqe->user_data = makeUserData(OpRecvRecord, slot.generation, conn.socket);
+}
+
+void IoUringBackend::submitSend(int fd, Slot& slot) {
+    slot.message = msghdr{};
+    slot.message.msg_iov = slot.inFlightSpans.data() + slot.firstSpan;
+    slot.message.msg_iovlen = slot.inFlightSpans.size() - slot.firstSpan;
+
+    io_uring_sqe* sqe = getSqe();
+    sqe->opcode = IORING_OP_SENDMSG;
+#ifdef IORING_SEND_ZC_REPORT_USAGE
+    if (slot.zeroCopy) {
+        sqe->opcode = IORING_OP_SENDMSG_ZC;
+        sqe->ioprio = IORING_SEND_ZC_REPORT_USAGE;
+    }
+#endif
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(&slot.message);
+    sqe->len = 1;
+    sqe->msg_flags = MSG_NOSIGNAL;
+    sqe->user_data = makeUserData(OpSend, slot.generation, fd);
+    slot.sendPending = true;
+}
+
+void IoUringBackend::submitPoll() {
+    io_uring_sqe* sqe = getSqe();
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = eventLoop.getFd();
+    sqe->poll32_events = POLLIN;
+    sqe->len = IORING_POLL_ADD_MULTI;
+    sqe->user_data = makeUserData(OpPoll, 0, eventLoop.getFd());
+}
+
+void IoUringBackend::submitListenPoll(int listenSocket) {
+    io_uring_sqe* sqe = getSqe();
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = listenSocket;
+    sqe->poll32_events = POLLIN;
+    sqe->user_data = makeUserData(OpListenPoll, 0, listenSocket);
+}
+
+void IoUringBackend::addListener(int listenSocket) {
+    submitAccept(listenSocket);
+}
+
+void IoUringBackend::addConnection(Connection& conn) {
+    uint32_t generation = nextGeneration++ & 0xFFFFFF;
+    Slot& slot = slots[conn.socket];
+    slot.conn = &conn;
+    slot.generation = generation;
+    slot.sendPending = false;
+    slot.zeroCopy = false;
+    slot.inFlight.clear();
+    slot.inFlightSpans.clear();
+    slot.firstSpan = 0;
+    conn.zeroCopy = zeroCopyThreshold > 0 && !conn.unixSocket;
+    if (conn.maxRecordSize > 0) {
+        submitRecordRecv(slot);
+    } else {
+        submitRecv(conn.socket, generation);
+    }
+}
+
+void IoUringBackend::removeConnection(Connection& conn) {
+    auto it = slots.find(conn.socket);
+    if (it == slots.end()) {
+        return;
+    }
+
+    Slot& slot = it->second;
+    if (slot.sendPending) {
+        // 아직 제출되지 않은 sendmsg가 msghdr를 참조하므로 먼저 제출한 뒤 프레임만 보관
+        submit(0, 0);
+        slot.conn = nullptr;
+        orphanedSends[makeUserData(OpSend, slot.generation, conn.socket)] = std::move(slot);
+    }
+    slots.erase(it);
+
+    // 소켓이 닫히기 전에 이 fd의 모든 작업을 취소해야 하므로 즉시 제출
+    io_uring_sqe* sqe = getSqe();
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = conn.socket;
+    sqe->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+    sqe->user_data = makeUserData(OpCancel, 0, conn.socket);
+    submit(0, 0);
+}
+
+void IoUringBackend::flush(Connection& conn) {
+    auto it = slots.find(conn.socket);
+    if (it == slots.end()) {
+        return;
+    }
+
+    Slot& slot = it->second;
+    if (slot.sendPending || conn.outbound.empty()) {
+        return;
+    }
+
+    // 대기 프레임을 최대 MAX_SEND_SPANS개까지 옮겨 sendmsg 하나로 제출
+    // (SEQPACKET은 sendmsg 하나가 레코드 하나이므로 프레임을 하나씩 보냄)
+    slot.inFlight.clear();
+    slot.inFlightSpans.clear();
+    slot.firstSpan = 0;
+    size_t firstOffset = conn.outboundOffset;
+    size_t maxFrames = conn.maxRecordSize > 0 ? 1 : MAX_SEND_SPANS;
+    while (!conn.outbound.empty() && slot.inFlight.size() < maxFrames) {
+        slot.inFlight.push_back(std::move(conn.outbound.front()));
+        conn.outbound.pop_front();
+    }
+    conn.outboundOffset = 0;
+
+    // 큰 프레임(스냅샷 등)이 섞여 있으면 커널 버퍼로 복사하지 않는 SENDMSG_ZC로 전송
+    slot.zeroCopy = false;
+    if (conn.zeroCopy) {
+        for (const auto& frame : slot.inFlight) {
+            if (frame->size() >= zeroCopyThreshold) {
+                slot.zeroCopy = true;
+                break;
+            }
+        }
+    }
+
+    for (const auto& frame : slot.inFlight) {
+        iovec span;
+        span.iov_base = const_cast<char*>(frame->data()) + firstOffset;
+        span.iov_len = frame->size() - firstOffset;
+        slot.inFlightSpans.push_back(span);
+        firstOffset = 0;
+    }
+    submitSend(conn.socket, slot);
+}
+
+void IoUringBackend::completeSend(Slot& slot, int result) {
+    Connection& conn = *slot.conn;
+    slot.sendPending = false;
+
+    if (result < 0) {
+        // 보낼 수 없는 연결이므로 큐를 비움 (종료는 수신 완료 이벤트에서 처리)
+        std::cerr << "메시지 전송 실패: " << strerror(-result) << std::endl;
+        slot.inFlight.clear();
+        slot.inFlightSpans.clear();
+        conn.outbound.clear();
+        conn.outboundOffset = 0;
+        conn.outboundBytes = 0;
+        callbacks.onSent(conn);
+        return;
+    }
+
+    conn.outboundBytes -= result;
+
+    // 부분 전송이면 남은 iovec부터 다시 제출
+    size_t sent = result;
+    while (slot.firstSpan < slot.inFlightSpans.size() && sent > 0) {
+        iovec& span = slot.inFlightSpans[slot.firstSpan];
+        if (sent < span.iov_len) {
+            span.iov_base = static_cast<char*>(span.iov_base) + sent;
+            span.iov_len -= sent;
+            sent = 0;
+            break;
+        }
+        sent -= span.iov_len;
+        ++slot.firstSpan;
+    }
+
+    if (slot.firstSpan < slot.inFlightSpans.size()) {
+        submitSend(conn.socket, slot);
+    } else {
+        slot.inFlight.clear();
+        slot.inFlightSpans.clear();
+        flush(conn);
+    }
+    callbacks.onSent(conn);
+}
+
+void IoUringBackend::releaseZeroCopy(const io_uring_cqe& cqe) {
+#ifdef IORING_SEND_ZC_REPORT_USAGE
+    auto held = zeroCopyHeld.find(cqe.user_data);
+    if (held != zeroCopyHeld.end()) {
+        held->second.pop_front();
+        if (held->second.empty()) {
+            zeroCopyHeld.erase(held);
+        }
+    }
+
+    // 루프백 등 커널이 결국 복사한 경우 zerocopy는 비용만 들므로 이 연결은 끔
+    if (cqe.res & IORING_NOTIF_USAGE_ZC_COPIED) {
+        uint32_t generation = static_cast<uint32_t>(cqe.user_data >> 32) & 0xFFFFFF;
+        auto it = slots.find(static_cast<int>(cqe.user_data & 0xFFFFFFFF));
+        if (it != slots.end() && it->second.generation == generation && it->second.conn->zeroCopy) {
+            it->second.conn->zeroCopy = false;
+            std::cout << "플레이어 " << it->second.conn->playerId
+                      << " zerocopy 비활성화 (커널이 복사로 처리)" << std::endl;
+        }
+    }
+#else
+    (void)cqe;
+#endif
+}
+
+int IoUringBackend::runOnce(int timeoutMs) {
+    // 쌓인 SQE(send 등)를 한 번에 제출하고 완료를 대기
+    submit(1, timeoutMs);
+
+    int handled = 0;
+    unsigned head = *cqHead;
+    unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+    while (head != tail) {
+        io_uring_cqe cqe = cqes[head & *cqMask];
+        ++head;
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+
+        handleCompletion(cqe);
+        handled++;
+    }
+    return handled;
+}
+
+bool IoUringBackend::setBusyPoll(unsigned usecs, unsigned budget) {
+    (void)budget;  // io_uring NAPI 설정에는 예산 항목이 없음
+#ifdef IORING_REGISTER_NAPI
+    // 완료를 기다리는 io_uring_enter 안에서 링에 등록된 소켓의 NAPI를 폴링 (리눅스 6.9 이상)
+    io_uring_napi napi{};
+    int result;
+    if (usecs > 0) {
+        napi.busy_poll_to = usecs;
+        napi.prefer_busy_poll = 1;
+        result = ioUringRegister(ringFd, IORING_REGISTER_NAPI, &napi, 1);
+    } else {
+        result = ioUringRegister(ringFd, IORING_UNREGISTER_NAPI, &napi, 1);
+    }
+    if (result < 0) {
+        std::cerr << "io_uring busy poll 설정 실패: " << strerror(errno) << std::endl;
+        return false;
+    }
+    return true;
+#else
+    (void)usecs;
+    return false;
+#endif
+}
+
+void IoUringBackend::handleCompletion(const io_uring_cqe& cqe) {
+    Operation op = static_cast<Operation>(cqe.user_data >> 56);
+    uint32_t generation = static_cast<uint32_t>(cqe.user_data >> 32) & 0xFFFFFF;
+    int fd = static_cast<int>(cqe.user_data & 0xFFFFFFFF);
+    bool more = cqe.flags & IORING_CQE_F_MORE;
+
+    switch (op) {
+        case OpAccept: {
+            if (cqe.res >= 0) {
+                callbacks.onAccept(fd, cqe.res);
+            } else {
+                // EMFILE 상태로 다시 제출만 하면 즉시 실패를 반복하므로 먼저 대기 연결을 정리
+                callbacks.onAcceptError(fd, -cqe.res);
+            }
+            if (!more) {
+                // io_uring의 accept는 대기 연결이 없어도 fd부터 할당하므로 fd 고갈 중에는
+                // 새 연결이 들어올 때까지 poll로 기다렸다가 다시 제출
+                if (cqe.res == -EMFILE || cqe.res == -ENFILE) {
+                    submitListenPoll(fd);
+                } else {
+                    submitAccept(fd);
+                }
+            }
+            break;
+        }
+
+        case OpListenPoll:
+            submitAccept(fd);
+            break;
+
+        case OpRecv: {
+            bool hasBuffer = cqe.flags & IORING_CQE_F_BUFFER;
+            uint16_t bufferId = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+
+            auto it = slots.find(fd);
+            bool current = it != slots.end() && it->second.generation == generation;
+
+            if (current && cqe.res > 0 && hasBuffer) {
+                Connection& conn = *it->second.conn;
+                conn.inbound.write(bufferBase + static_cast<size_t>(bufferId) * BUFFER_SIZE, cqe.res);
+                callbacks.onReadable(conn);
+            }
+            if (hasBuffer) {
+                recycleBuffer(bufferId);
+            }
+            if (!current) {
+                break;
+            }
+
+            // 콜백에서 연결이 닫혔을 수 있으므로 다시 조회
+            it = slots.find(fd);
+            if (it == slots.end() || it->second.generation != generation) {
+                break;
+            }
+
+            if (cqe.res == 0 || (cqe.res < 0 && cqe.res != -ENOBUFS)) {
+                callbacks.onClosed(*it->second.conn);
+            } else if (!more) {
+                // 버퍼 부족 등으로 멀티샷이 끝난 경우 다시 등록
+                submitRecv(fd, generation);
+            }
+            break;
+        }
+
+        case OpRecvRecord: {
+            auto it = slots.find(fd);
+            if (it == slots.end() || it->second.generation != generation) {
+                break;
+            }
+
+            Slot& slot = it->second;
+            Connection& conn = *slot.conn;
+            if (cqe.res == -EINTR || cqe.res == -EAGAIN) {
+                submitRecordRecv(slot);
+                break;
+            }
+            if (cqe.res <= 0) {
+                callbacks.onClosed(conn);
+                break;
+            }
+            if (static_cast<size_t>(cqe.res) > slot.recvRequested) {
+                std::cerr << "플레이어 " << conn.playerId << " 레코드 크기 초과 (" << cqe.res
+                          << " 바이트), 연결 종료" << std::endl;
+                callbacks.onClosed(conn);
+                break;
+            }
+
+            conn.inbound.commitWrite(cqe.res);
+            callbacks.onReadable(conn);
+
+            // 콜백에서 연결이 닫혔을 수 있으므로 다시 조회
+            it = slots.find(fd);
+            if (it != slots.end() && it->second.generation == generation) {
+                submitRecordRecv(it->second);
+            }
+            break;
+        }
+
+        case OpSend: {
+#ifdef IORING_SEND_ZC_REPORT_USAGE
+            if (cqe.flags & IORING_CQE_F_NOTIF) {
+                releaseZeroCopy(cqe);
+                break;
+            }
+#endif
+            auto it = slots.find(fd);
+            bool live = it != slots.end() && it->second.generation == generation;
+
+            // zerocopy 전송은 결과 뒤에 버퍼 해제 알림이 따로 오므로 그때까지 프레임 유지
+            if (more) {
+                auto orphan = orphanedSends.find(cqe.user_data);
+                if (live) {
+                    zeroCopyHeld[cqe.user_data].push_back(it->second.inFlight);
+                } else if (orphan != orphanedSends.end()) {
+                    zeroCopyHeld[cqe.user_data].push_back(std::move(orphan->second.inFlight));
+                }
+            }
+
+            if (!live) {
+                orphanedSends.erase(cqe.user_data);
+                break;
+            }
+
+            Slot& slot = it->second;
+            if (slot.zeroCopy && (cqe.res == -EINVAL || cqe.res == -EOPNOTSUPP)) {
+                // 커널이 SENDMSG_ZC를 지원하지 않으면 일반 sendmsg로 다시 보냄
+                std::cout << "SENDMSG_ZC 미지원, 일반 전송으로 전환" << std::endl;
+                zeroCopyThreshold = 0;
+                slot.conn->zeroCopy = false;
+                slot.zeroCopy = false;
+                submitSend(fd, slot);
+                break;
+            }
+
+            completeSend(slot, cqe.res);
+            break;
+        }
+
+        case OpPoll: {
+            eventLoop.runOnce(0);
+            if (!more) {
+                submitPoll();
+            }
+            break;
+        }
+
+        case OpCancel:
+            break;
+    }
+}
+
+#else
+
+IoUringBackend::IoUringBackend(EventLoop& loop, const Callbacks& cb, size_t) : eventLoop(loop), callbacks(cb) {
+    throw std::runtime_error("io_uring 미지원 빌드: 커널 헤더 6.0 이상 필요");
+}
+
+IoUringBackend::~IoUringBackend() {}
+void IoUringBackend::addListener(int) {}
+void IoUringBackend::addConnection(Connection&) {}
+void IoUringBackend::removeConnection(Connection&) {}
+void IoUringBackend::flush(Connection&) {}
+int IoUringBackend::runOnce(int) { return 0; }
+bool IoUringBackend::setBusyPoll(unsigned, unsigned) { return false; }
+
+#endif
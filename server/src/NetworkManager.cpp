@@ -1,23 +1,204 @@
 #include "NetworkManager.hpp"
+#include "EpollBackend.hpp"
+#include "IoUringBackend.hpp"
 #include <sys/socket.h>
 #include <netinet/in.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <cstddef>
+#include <algorithm>
 #include <iostream>
-#include <thread>
+#include <unordered_set>
 #include <string.h> // strerror 사용을 위해 추가
 #include "SimpleMessagePack.hpp"
 
-NetworkManager::NetworkManager(int port, EventBus& bus) : eventBus(bus) {
-    listenSocket = socket(AF_INET, SOCK_STREAM, 0);
+// 소켓을 논블로킹 모드로 전환
+static bool setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) >= 0;
+}
+
+// 현재 스레드가 실행 중인 샤드 (리액터 스레드가 아니면 nullptr)
+static thread_local const void* currentShard = nullptr;
+
+static int64_t monotonicNs() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+static int64_t monotonicMs() {
+    return monotonicNs() / 1000000;
+}
+
+// ping/pong에 싣는 서버 시각 (클라이언트 벽시계와 비교해야 하므로 CLOCK_REALTIME, 마이크로초)
+static int64_t wallClockUs() {
+    timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    return now.tv_sec * 1000000LL + now.tv_nsec / 1000;
+}
+
+NetworkManager::Shard::~Shard() {
+    for (auto& item : connections) {
+        close(item.first);
+    }
+    // 닫는 중이던 zerocopy 연결: 아직 완료되지 않은 프레임은 곧 해제되므로 RST로 닫아 커널이 송신 큐를 버리게 함
+    for (auto& item : zeroCopyClosing) {
+        Connection& conn = *item.second;
+        backend->reapZeroCopyCompletions(conn);
+        if (!conn.zeroCopyPending.empty()) {
+            linger abort{1, 0};
+            setsockopt(conn.socket, SOL_SOCKET, SO_LINGER, &abort, sizeof(abort));
+        }
+        close(conn.socket);
+    }
+    if (listenSocket >= 0) {
+        close(listenSocket);
+    }
+    if (busyPollListenSocket >= 0) {
+        close(busyPollListenSocket);
+    }
+    if (spareFd >= 0) {
+        close(spareFd);
+    }
+}
+
+NetworkManager::NetworkManager(const ServerConfig& serverConfig, EventBus& bus) :
+    eventBus(bus),
+    config(serverConfig),
+    running(true),
+    // 게이트웨이는 시뮬레이션 프로세스를 함께 쓰는 다른 게이트웨이와 겹치지 않는 범위 안에서만 할당
+    playerIds(serverConfig.role == ServerConfig::Role::Gateway ? PlayerIdAllocator::forGateway(serverConfig.gatewayId)
+                                                               : PlayerIdAllocator()),
+    handoff(config) {
+    int reactorCount = config.reactorCount;
+    if (reactorCount <= 0) {
+        reactorCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // 리액터가 여러 개면 SO_REUSEPORT로 같은 포트에 리슨 소켓을 하나씩 열어
+    // 커널이 연결 수락을 리액터들에 분산하도록 함
+    bool reusePort = reactorCount > 1;
+
+    // 무중단 재시작: 리슨 소켓을 새로 열지 않고 이전 프로세스에서 넘겨받음 (대기 중인 연결도 그대로 유지)
+    if (!config.takeoverPath.empty()) {
+        handoff.receive(reactorCount);
+        playerIds.resumeFrom(handoff.takenState()["player_id_cursor"].intValue);
+    }
+    const MessageData& takeoverState = handoff.takenState();
+
+    // 로컬 봇/게이트웨이용 AF_UNIX 리슨 소켓은 하나만 열고 모든 샤드의 백엔드에 등록
+    if (!config.unixPath.empty()) {
+        unixListenSocket = handoff.takingOver() ? handoff.inherited(takeoverState["unix_listener"]) : openUnixListenSocket();
+    }
+
+    for (int i = 0; i < reactorCount; ++i) {
+        shards.push_back(std::make_unique<Shard>());
+        Shard& shard = *shards.back();
+        shard.index = i;
+        if (handoff.takingOver()) {
+            const MessageData& listeners = takeoverState["listeners"][i];
+            shard.listenSocket = handoff.inherited(listeners[0]);
+            shard.busyPollListenSocket = handoff.inherited(listeners[1]);
+        } else {
+            shard.listenSocket = openListenSocket(config.port, reusePort);
+            if (config.busyPollPort > 0) {
+                shard.busyPollListenSocket = openListenSocket(config.busyPollPort, reusePort);
+                configureBusyPoll(shard.busyPollListenSocket);
+            }
+        }
+        shard.spareFd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+
+        // 이벤트 시작 때 연결이 몰려도 수락 경로에서 할당하지 않도록 슬롯을 미리 만들어 둠
+        shard.freeConnections.reserve(PREALLOCATED_CONNECTIONS);
+        for (size_t slot = 0; slot < PREALLOCATED_CONNECTIONS; ++slot) {
+            shard.freeConnections.push_back(
+                std::make_unique<Connection>(-1, -1, &shard.bufferPool, config.maxFrameSize));
+        }
+
+        NetworkBackend::Callbacks callbacks;
+        callbacks.onAccept = [this, &shard](int listenSocket, int clientSocket) {
+            acceptClient(shard, listenSocket, clientSocket);
+        };
+        callbacks.onAcceptError = [this, &shard](int listenSocket, int error) {
+            handleAcceptError(shard, listenSocket, error);
+        };
+        callbacks.onReadable = [this, &shard](Connection& conn) {
+            conn.lastActivityTick = shard.timers.now();
+            handleClientMessages(shard, conn);
+        };
+        callbacks.onClosed = [this, &shard](Connection& conn) {
+            closeConnection(shard, conn);
+        };
+        callbacks.onSent = [this](Connection& conn) {
+            updateBackpressure(conn);
+        };
+
+        if (config.backend == ServerConfig::Backend::IoUring) {
+            shard.backend = std::make_unique<IoUringBackend>(shard.eventLoop, callbacks, config.zeroCopyThreshold);
+        } else {
+            shard.backend = std::make_unique<EpollBackend>(shard.eventLoop, callbacks, config.zeroCopyThreshold);
+        }
+        shard.backend->addListener(shard.listenSocket);
+        if (shard.busyPollListenSocket >= 0) {
+            shard.backend->addListener(shard.busyPollListenSocket);
+        }
+        if (unixListenSocket >= 0) {
+            shard.backend->addListener(unixListenSocket);
+        }
+    }
+
+    sessions = std::make_unique<SessionRegistry>(config.sessionGraceMs, shards[0]->eventLoop, shards[0]->timers, eventBus);
+    roomRouter = std::make_unique<RoomRouter>(config, eventBus, *sessions,
+        [this](int playerId, const MessageData& message) {
+            sendToPlayer(playerId, packMessage(message));
+        });
+
+    if (config.udpPort > 0) {
+        udpChannel = std::make_unique<UdpInputChannel>(
+            config.udpPort, shards[0]->eventLoop, eventBus,
+            [this](const char* data, size_t length) {
+                return unpackMessage(data, length);
+            },
+            shuttingDown, config.inputRate, config.inputBurst);
+    }
+
+    std::cout << "네트워크 백엔드: "
+              << (config.backend == ServerConfig::Backend::IoUring ? "io_uring" : "epoll")
+              << ", 리액터 " << reactorCount << "개" << std::endl;
+    if (config.busyPollPort > 0 || config.unixBusyPoll) {
+        std::cout << "busy-poll 모드: 포트 " << config.busyPollPort << (config.unixBusyPoll ? " + 유닉스 소켓" : "")
+                  << ", 스핀 " << config.busySpinUs << "us, 커널 폴링 " << config.busyPollUs << "us" << std::endl;
+    }
+
+    // 넘겨받는 중이면 이전 프로세스가 아직 이 경로에서 기다리므로 복원을 마친 뒤에 엶
+    if (!config.handoffPath.empty() && !handoff.takingOver()) {
+        openHandoffListener();
+    }
+    
+    setupEventHandlers();
+}
+
+int NetworkManager::openListenSocket(int port, bool reusePort) {
+    int listenSocket = socket(AF_INET, SOCK_STREAM, 0);
     if (listenSocket < 0) {
         throw std::runtime_error("소켓 생성 실패");
     }
 
     int opt = 1;
     if (setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) < 0) {
+        close(listenSocket);
         throw std::runtime_error("소켓 옵션 설정 실패");
     }
 
+    if (reusePort && setsockopt(listenSocket, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt)) < 0) {
+        close(listenSocket);
+        throw std::runtime_error("SO_REUSEPORT 설정 실패: " + std::string(strerror(errno)));
+    }
+
     sockaddr_in serverAddr{};  // zero initialization 추가
     serverAddr.sin_family = AF_INET;
     serverAddr.sin_addr.s_addr = INADDR_ANY;
@@ -32,8 +213,79 @@ NetworkManager::NetworkManager(int port, EventBus& bus) : eventBus(bus) {
         close(listenSocket);
         throw std::runtime_error("리슨 실패");
     }
-    
-    setupEventHandlers();
+
+    if (!setNonBlocking(listenSocket)) {
+        close(listenSocket);
+        throw std::runtime_error("리슨 소켓 논블로킹 설정 실패");
+    }
+
+    return listenSocket;
+}
+
+void NetworkManager::configureBusyPoll(int listenSocket) {
+    // 수락된 소켓은 리슨 소켓의 옵션을 물려받으므로 리슨 소켓에 한 번만 설정
+    // 값을 올리려면 CAP_NET_ADMIN이 필요하며, 실패해도 리액터 스핀은 그대로 동작
+    int usecs = config.busyPollUs;
+    int budget = config.busyPollBudget;
+    int prefer = 1;
+    if (setsockopt(listenSocket, SOL_SOCKET, SO_BUSY_POLL, &usecs, sizeof(usecs)) < 0 ||
+        setsockopt(listenSocket, SOL_SOCKET, SO_PREFER_BUSY_POLL, &prefer, sizeof(prefer)) < 0 ||
+        setsockopt(listenSocket, SOL_SOCKET, SO_BUSY_POLL_BUDGET, &budget, sizeof(budget)) < 0) {
+        std::cerr << "소켓 busy poll 설정 실패 (스핀 대기만 사용): " << strerror(errno) << std::endl;
+    }
+}
+
+void NetworkManager::updateBusyPoll(Shard& shard, int delta) {
+    int before = shard.busyPollConnections;
+    shard.busyPollConnections += delta;
+
+    // 저지연 연결이 생기거나 모두 사라질 때만 대기 호출의 커널 폴링을 켜고 끔
+    if (before == 0 && shard.busyPollConnections > 0) {
+        shard.backend->setBusyPoll(config.busyPollUs, config.busyPollBudget);
+    } else if (before > 0 && shard.busyPollConnections == 0) {
+        shard.backend->setBusyPoll(0, 0);
+    }
+}
+
+int NetworkManager::openUnixListenSocket() {
+    int type = config.unixSeqPacket ? SOCK_SEQPACKET : SOCK_STREAM;
+    int listenSocket = socket(AF_UNIX, type | SOCK_CLOEXEC, 0);
+    if (listenSocket < 0) {
+        throw std::runtime_error("유닉스 소켓 생성 실패: " + std::string(strerror(errno)));
+    }
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (config.unixPath.size() >= sizeof(addr.sun_path)) {
+        close(listenSocket);
+        throw std::runtime_error("유닉스 소켓 경로가 너무 김: " + config.unixPath);
+    }
+
+    // 추상 네임스페이스는 sun_path 첫 바이트가 0이고 주소 길이로 이름의 끝을 정함
+    bool abstract = config.unixPath[0] == '@';
+    memcpy(addr.sun_path, config.unixPath.data(), config.unixPath.size());
+    socklen_t addrLength = offsetof(sockaddr_un, sun_path) + config.unixPath.size();
+    if (abstract) {
+        addr.sun_path[0] = '\0';
+    } else {
+        // 이전 실행이 남긴 소켓 파일이 있으면 바인드가 실패하므로 먼저 제거
+        unlink(config.unixPath.c_str());
+        addrLength += 1;
+    }
+
+    if (::bind(listenSocket, (struct sockaddr*)&addr, addrLength) < 0) {
+        close(listenSocket);
+        throw std::runtime_error("유닉스 소켓 바인드 실패: " + std::string(strerror(errno)));
+    }
+
+    if (listen(listenSocket, SOMAXCONN) < 0 || !setNonBlocking(listenSocket)) {
+        close(listenSocket);
+        throw std::runtime_error("유닉스 소켓 리슨 실패: " + std::string(strerror(errno)));
+    }
+
+    std::cout << "유닉스 소켓 리슨: " << config.unixPath
+              << (config.unixSeqPacket ? " (SOCK_SEQPACKET)" : " (SOCK_STREAM)") << std::endl;
+    return listenSocket;
 }
 
 // MessagePack 관련 메서드 구현
@@ -41,30 +293,10 @@ std::string NetworkManager::packMessage(const MessageData& message) {
     return SimpleMessagePack::pack(message);
 }
 
-MessageData NetworkManager::unpackMessage(const std::string& data) {
+MessageData NetworkManager::unpackMessage(const char* data, size_t length) {
     try {
-        // MessagePack 데이터 역직렬화
-        msgpack::object_handle oh = msgpack::unpack(data.data(), data.size());
-        msgpack::object obj = oh.get();
-        
-        // 디버깅을 위한 출력
-        std::cout << "MessagePack 객체: " << obj << std::endl;
-        
-        // MessageData로 변환
-        MessageData result;
-        if (obj.type == msgpack::type::MAP) {
-            msgpack::object_map map = obj.via.map;
-            for (unsigned int i = 0; i < map.size; ++i) {
-                std::string key = map.ptr[i].key.as<std::string>();
-                if (map.ptr[i].val.type == msgpack::type::STR) {
-                    result[key] = map.ptr[i].val.as<std::string>();
-                }
-                // 다른 타입들도 필요한 경우 여기에 추가
-            }
-        }
-        
-        std::cout << "변환된 MessageData: " << result.dump() << std::endl;
-        return result;
+        // 클라이언트는 표준 MessagePack 맵을 보냄 (서버 → 클라이언트는 packMessage의 자체 형식)
+        return SimpleMessagePack::unpackMsgPack(data, length);
     }
     catch (const std::exception& e) {
         std::cerr << "메시지 언패킹 오류: " << e.what() << std::endl;
@@ -82,6 +314,15 @@ void NetworkManager::setupEventHandlers() {
         response["type"] = "connect_response";
         response["player_id"] = playerId;
         response["status"] = "success";
+        if (udpChannel) {
+            // UDP 입력 채널 사용 시 인증 토큰과 포트를 함께 전달
+            response["udp_port"] = udpChannel->getPort();
+            response["udp_token"] = udpChannel->issueToken(playerId);
+        }
+        if (config.sessionGraceMs > 0) {
+            // 연결이 끊겼을 때 같은 플레이어로 이어서 진행하기 위한 재연결 토큰
+            response["session_token"] = sessions->issue(playerId);
+        }
         
         std::cout << "플레이어 " << playerId << "에게 연결 응답 전송" << std::endl;
         sendToPlayer(playerId, packMessage(response));
@@ -94,7 +335,6 @@ void NetworkManager::setupEventHandlers() {
     
     // 게임 상태 업데이트 이벤트 구독
     eventBus.subscribe("game_state_updated", [this](const Event& event) {
-        std::cout << "게임 상태 업데이트 이벤트 수신, 브로드캐스트 시작" << std::endl;
         broadcastGameState(event.data);
     });
     
@@ -104,39 +344,10 @@ void NetworkManager::setupEventHandlers() {
         
         if (action == "player_socket_info") {
             int playerId = event.data["player_id"].intValue;
-            int socket = event.data["socket"].intValue;
             
             if (event.data.contains("message")) {
                 std::string message = event.data["message"];
-                std::cout << "플레이어 " << playerId << "에게 메시지 전송" << std::endl;
-                
-                int bytesSent = send(socket, message.c_str(), message.length(), 0);
-                if (bytesSent < 0) {
-                    std::cerr << "메시지 전송 실패: " << strerror(errno) << std::endl;
-                } else {
-                    std::cout << "전송된 바이트: " << bytesSent << std::endl;
-                }
-            }
-        }
-        else if (action == "all_players_info") {
-            if (event.data.contains("game_state") && event.data.contains("players")) {
-                MessageData gameState = event.data["game_state"];
-                std::string packedMsg = packMessage(gameState);
-                
-                std::cout << "모든 플레이어에게 게임 상태 전송" << std::endl;
-                
-                MessageData players = event.data["players"];
-                for (auto& item : players.objectValue) {
-                    const std::string& id = item.first;
-                    MessageData& player = item.second;
-                    int socket = player["socket"].intValue;
-                    int bytesSent = send(socket, packedMsg.c_str(), packedMsg.length(), 0);
-                    if (bytesSent < 0) {
-                        std::cerr << "플레이어 " << id << "에게 게임 상태 전송 실패: " << strerror(errno) << std::endl;
-                    } else {
-                        std::cout << "플레이어 " << id << "에게 " << bytesSent << " 바이트 전송" << std::endl;
-                    }
-                }
+                sendToPlayer(playerId, message);
             }
         }
     });
@@ -146,166 +357,1290 @@ void NetworkManager::setupEventHandlers() {
         std::cout << "클라이언트 연결 이벤트 수신: 플레이어 ID " << event.data["player_id"].intValue << std::endl;
     });
     
-    eventBus.subscribe("client_message_received", [](const Event& event) {
-        std::cout << "클라이언트 메시지 수신: " << event.data.dump() << std::endl;
+    if (config.verboseLog) {
+        eventBus.subscribe("client_message_received", [](const Event& event) {
+            std::cout << "클라이언트 메시지 수신: " << event.data.dump() << std::endl;
+        });
+    }
+
+    // 연결이 끊긴 플레이어의 UDP 토큰과 재연결 토큰 폐기
+    eventBus.subscribe("client_disconnected", [this](const Event& event) {
+        int playerId = event.data["player_id"].intValue;
+        if (udpChannel) {
+            udpChannel->revokeToken(playerId);
+        }
+
+        sessions->revoke(playerId);
+
+        std::lock_guard<std::mutex> lock(routeMutex);
+        finishedPlayers.erase(playerId);
+    });
+
+    // 드레인은 게임 오버가 나지 않은 플레이어가 남아 있는 동안 기다림
+    eventBus.subscribe("game_over", [this](const Event& event) {
+        std::lock_guard<std::mutex> lock(routeMutex);
+        finishedPlayers.insert(event.data["player_id"].intValue);
     });
 
     // 게임 상태 변경 이벤트 구독
+    // 방 이동 스냅샷은 room_export를 보낸 관리 연결로
+    eventBus.subscribe("room_snapshot", [this](const Event& event) {
+        sendToPlayer(event.data["player_id"].intValue, packMessage(event.data));
+    });
+
+    // 무중단 재시작용 전체 게임 상태 (리액터가 모두 멈춘 뒤 handOff에서 요청)
+    eventBus.subscribe("game_snapshot", [this](const Event& event) {
+        gameSnapshot = event.data;
+    });
+
     eventBus.subscribe("game_state_changed", [this](const Event& event) {
         int playerId = event.data["player_id"].intValue;
         sendToPlayer(playerId, packMessage(event.data));
     });
 }
 
-void NetworkManager::handleClientMessages(int playerId, int clientSocket) {
-    char headerBuffer[4];
-    
+void NetworkManager::checkHeartbeat(Shard& shard, Connection& conn) {
+    // 수신할 때마다 타이머를 옮기지 않고, 만료 시점에 마지막 수신 시각을 보고 다음 확인 시점을 정함
+    uint64_t now = shard.timers.now();
+    uint64_t idleTicks = now - conn.lastActivityTick;
+    uint64_t nextCheck = UINT64_MAX;
+
+    if (config.idleTimeoutMs > 0) {
+        uint64_t timeoutTicks = shard.timers.toTicks(config.idleTimeoutMs);
+        if (idleTicks >= timeoutTicks) {
+            std::cout << "플레이어 " << conn.playerId << " 응답 없음 (" << idleTicks * TIMER_TICK_MS
+                      << "ms), 연결 종료" << std::endl;
+            closeConnection(shard, conn);
+            return;
+        }
+        nextCheck = timeoutTicks - idleTicks;
+    }
+
+    // 하트비트는 유휴 상태에서만, 지연 측정용 ping은 수신 여부와 관계없이 주기적으로 보냄
+    auto nextPingTick = [this, &shard, &conn]() {
+        uint64_t due = UINT64_MAX;
+        if (config.heartbeatIntervalMs > 0) {
+            uint64_t intervalTicks = shard.timers.toTicks(config.heartbeatIntervalMs);
+            due = std::max(conn.lastActivityTick, conn.lastPingTick) + intervalTicks;
+        }
+        if (config.rttProbeIntervalMs > 0) {
+            due = std::min(due, conn.lastPingTick + shard.timers.toTicks(config.rttProbeIntervalMs));
+        }
+        return due;
+    };
+
+    uint64_t pingTick = nextPingTick();
+    if (pingTick <= now) {
+        sendPing(shard, conn);
+        pingTick = nextPingTick();
+    }
+    if (pingTick != UINT64_MAX) {
+        nextCheck = std::min(nextCheck, pingTick - now);
+    }
+
+    if (!conn.closed) {
+        shard.timers.schedule(conn.heartbeatTimer, nextCheck);
+    }
+}
+
+void NetworkManager::sendPing(Shard& shard, Connection& conn) {
+    MessageData ping;
+    ping["type"] = "ping";
+    ping["server_time"] = wallClockUs();
+
+    // 응답은 마지막 ping 하나만 기다림 (이전 ping의 늦은 pong은 표본에서 제외)
+    conn.latency.pendingServerTimeUs = ping["server_time"].intValue;
+    conn.latency.pendingSentNs = monotonicNs();
+    conn.lastPingTick = shard.timers.now();
+    enqueueFrame(shard, conn, makeFrame(packMessage(ping)));
+}
+
+void NetworkManager::handlePong(Connection& conn, MessageData& msg) {
+    LatencyEstimator& latency = conn.latency;
+    if (latency.pendingSentNs == 0 || !msg.contains("server_time") ||
+        msg["server_time"].intValue != latency.pendingServerTimeUs) {
+        return;
+    }
+
+    // RTT는 서버 단조 시계로만 계산 (벽시계 조정에 영향받지 않음)
+    int64_t rttUs = (monotonicNs() - latency.pendingSentNs) / 1000;
+    latency.pendingSentNs = 0;
+    latency.addSample(rttUs);
+    if (msg.contains("client_time")) {
+        latency.addClockSample(rttUs, latency.pendingServerTimeUs, msg["client_time"].intValue);
+    }
+
+    // 지표 수집/매치메이킹 등에서 구독할 수 있도록 측정값 발행
+    MessageData metrics;
+    metrics["player_id"] = conn.playerId;
+    metrics["rtt_us"] = latency.smoothedRttUs;
+    metrics["min_rtt_us"] = latency.minRttUs;
+    metrics["jitter_us"] = latency.jitterUs;
+    if (latency.clockSamples > 0) {
+        metrics["clock_offset_us"] = latency.clockOffsetUs;
+    }
+    eventBus.publish("client_latency", metrics);
+}
+
+void NetworkManager::resumeSession(Shard& shard, Connection& conn, const MessageData& msg) {
+    int64_t token = msg.contains("session_token") ? msg["session_token"].intValue : 0;
+    int provisionalId = conn.playerId;
+    int playerId = -1;
+    PlayerRoute previous{nullptr, -1};
+
+    {
+        std::lock_guard<std::mutex> lock(routeMutex);
+        playerId = sessions->claim(token, provisionalId);
+        if (playerId >= 0) {
+            // 이전 연결의 끊김을 아직 감지하지 못했으면 새 연결이 경로를 넘겨받음
+            auto route = playerRoutes.find(playerId);
+            if (route != playerRoutes.end()) {
+                previous = route->second;
+            }
+            playerRoutes.erase(provisionalId);
+            playerRoutes[playerId] = PlayerRoute{&shard, conn.socket};
+        }
+    }
+
+    if (playerId < 0) {
+        // 만료된 세션이면 이 연결에 배정된 ID로 새 플레이어를 만들어 계속 진행 (connect와 같은 응답이 이어짐)
+        std::cout << "플레이어 " << provisionalId << " 세션 재개 실패 (만료된 토큰)" << std::endl;
+        MessageData response;
+        response["type"] = "resume_response";
+        response["status"] = "expired";
+        response["player_id"] = provisionalId;
+        sendToPlayer(provisionalId, packMessage(response));
+        if (!conn.handshaken) {
+            conn.handshaken = true;
+            pendingHandshakes--;
+            eventBus.publish("client_connected", {
+                {"player_id", provisionalId},
+                {"socket", conn.socket}
+            });
+        }
+        return;
+    }
+
+    std::cout << "플레이어 " << playerId << " 세션 재개 (새 연결에 배정된 ID " << provisionalId << " 대신 사용)" << std::endl;
+    conn.playerId = playerId;
+    bool provisionalCreated = conn.handshaken;
+    if (!conn.handshaken) {
+        conn.handshaken = true;
+        pendingHandshakes--;
+    }
+
+    // 이 연결이 먼저 connect를 보냈으면 그때 만든 임시 플레이어 정리
+    if (provisionalCreated) {
+        eventBus.publish("client_disconnected", {{"player_id", provisionalId}});
+    }
+
+    // 이전 연결은 소유 샤드에서 닫음 (경로가 넘어갔으므로 끊김 이벤트는 발행되지 않음)
+    if (previous.shard) {
+        Shard* target = previous.shard;
+        int socket = previous.socket;
+        target->eventLoop.post([this, target, socket, playerId]() {
+            auto it = target->connections.find(socket);
+            if (it != target->connections.end() && it->second->playerId == playerId) {
+                closeConnection(*target, *it->second);
+            }
+        });
+    }
+
+    MessageData response;
+    response["type"] = "resume_response";
+    response["status"] = "success";
+    response["player_id"] = playerId;
+    response["session_token"] = token;
+    if (udpChannel) {
+        response["udp_port"] = udpChannel->getPort();
+        response["udp_token"] = udpChannel->issueToken(playerId);
+    }
+    sendToPlayer(playerId, packMessage(response));
+
+    // 게임 계층이 클라이언트가 마지막으로 받은 상태 이후의 변경분만 보냄
+    eventBus.publish("client_resumed", {
+        {"player_id", playerId},
+        {"last_state_seq", msg.contains("last_state_seq") ? msg["last_state_seq"].intValue : int64_t(-1)}
+    });
+}
+
+void NetworkManager::handleClientMessages(Shard& shard, Connection& conn) {
+    // 완성된 프레임을 모두 처리하고, 부분 프레임은 링 버퍼에 남겨 다음 수신에서 이어서 처리
+    int64_t nowNs = monotonicNs();
+    size_t frames = conn.decoder.decode(conn.inbound, [this, &shard, &conn, nowNs](const char* data, size_t length) {
+        return handleFrame(shard, conn, data, length, nowNs);
+    });
+
+    // 이번 수신분의 처리가 끝났음을 알려 게임 상태 변경을 한 프레임으로 모아 보내게 함
+    if (frames > 0) {
+        eventBus.publish("client_messages_processed", {{"player_id", conn.playerId}});
+    }
+
+    // 최대 크기를 넘는 길이 헤더는 메모리를 확보하기 전에 거부하고 연결 종료
+    if (conn.decoder.failed() && !conn.closed) {
+        std::cerr << "플레이어 " << conn.playerId << " 프레임 크기 초과 (" << conn.decoder.pendingFrameSize()
+                  << " 바이트, 최대 " << config.maxFrameSize << "), 연결 종료" << std::endl;
+        closeConnection(shard, conn);
+    }
+}
+
+bool NetworkManager::handleFrame(Shard& shard, Connection& conn, const char* data, size_t length, int64_t nowNs) {
+    // 종료 직전에는 결과를 이미 기록했으므로 입력을 반영하지 않음
+    if (shuttingDown) {
+        return true;
+    }
+    dispatchMessage(shard, conn, data, length, nowNs);
+    return !conn.closed;
+}
+
+bool NetworkManager::takeInputToken(Connection& conn, int64_t nowNs) {
+    // 로컬 봇은 초당 수천 프레임을 보내므로 네트워크 클라이언트와 다른 예산을 씀
+    double rate = conn.unixSocket ? config.localInputRate : config.inputRate;
+    double burst = conn.unixSocket ? config.localInputBurst : config.inputBurst;
+    if (conn.inputBucket.take(rate, burst, nowNs)) {
+        return true;
+    }
+    uint64_t total = ++droppedInputs;
+    if (conn.droppedInputs++ == 0) {
+        std::cerr << "플레이어 " << conn.playerId << " 입력 속도 제한 초과, 초과 입력을 버림 (전체 "
+                  << total << "개)" << std::endl;
+    }
+    return false;
+}
+
+void NetworkManager::attachSharedMemory(Shard& shard, Connection& conn) {
+    MessageData response;
+    response["type"] = "shm_ready";
+
+    const char* status = nullptr;
+    if (!conn.unixSocket || config.sharedRingSize == 0) {
+        status = "unsupported";
+    } else if (conn.sharedChannel) {
+        status = "already_attached";
+    } else if (conn.outboundBytes > 0) {
+        // 소켓으로 보낼 프레임이 남아 있으면 공유 링의 프레임과 순서가 섞이므로 비운 뒤 다시 요청
+        status = "retry";
+    }
+
+    std::unique_ptr<SharedMemoryChannel> channel;
+    if (!status) {
+        try {
+            channel = std::make_unique<SharedMemoryChannel>(config.sharedRingSize, config.maxFrameSize);
+        }
+        catch (const std::exception& e) {
+            std::cerr << "플레이어 " << conn.playerId << " 공유 메모리 채널 생성 실패: " << e.what() << std::endl;
+            status = "failed";
+        }
+    }
+
+    if (status) {
+        response["status"] = status;
+        enqueueFrame(shard, conn, makeFrame(packMessage(response)));
+        return;
+    }
+
+    // 응답 프레임과 함께 memfd, 서버 도어벨, 봇 도어벨을 넘김 (fd 순서는 고정)
+    response["status"] = "success";
+    response["ring_size"] = static_cast<int64_t>(channel->ringSize());
+    response["data_offset"] = static_cast<int64_t>(SharedMemoryChannel::DATA_OFFSET);
+    if (!channel->sendHandshake(conn.socket, packMessage(response))) {
+        // 프레임 일부만 나갔을 수 있어 스트림을 이어 쓸 수 없음
+        std::cerr << "플레이어 " << conn.playerId << " 공유 메모리 핸드셰이크 전송 실패, 연결 종료" << std::endl;
+        closeConnection(shard, conn);
+        return;
+    }
+
+    Connection* connection = &conn;
+    shard.eventLoop.addFd(channel->serverDoorbell(), EPOLLIN | EPOLLET, [this, &shard, connection](uint32_t) {
+        connection->sharedChannel->drainDoorbell();
+        pollSharedChannel(shard, *connection, shard.busyPollConnections == 0);
+    });
+    conn.sharedChannel = std::move(channel);
+    shard.sharedConnections.push_back(&conn);
+
+    // 첫 프레임부터 도어벨을 받도록 대기 표시
+    conn.sharedChannel->inbound().prepareConsumerWait();
+
+    std::cout << "플레이어 " << conn.playerId << " 공유 메모리 전송 전환 (링 " << conn.sharedChannel->ringSize()
+              << " 바이트 x 2)" << std::endl;
+}
+
+size_t NetworkManager::pollSharedChannel(Shard& shard, Connection& conn, bool arm) {
+    SharedMemoryChannel& channel = *conn.sharedChannel;
+    SharedRing& ring = channel.inbound();
+    size_t frames = 0;
+
+    // arm이면 링이 빈 것을 확인하고 도어벨을 요청할 때까지 반복 (잠든 뒤 도착한 데이터를 놓치지 않음)
     while (true) {
-        // 메시지 길이 정보(4바이트) 읽기
-        int bytesRead = recv(clientSocket, headerBuffer, 4, 0);
-        if (bytesRead <= 0) {
-            std::cout << "플레이어 " << playerId << " 연결 종료" << std::endl;
-            eventBus.publish("client_disconnected", {{"player_id", playerId}});
-            close(clientSocket);
+        int64_t nowNs = monotonicNs();
+        frames += channel.decoder().decode(ring, [this, &shard, &conn, nowNs](const char* data, size_t length) {
+            return handleFrame(shard, conn, data, length, nowNs);
+        });
+
+        // 읽은 만큼 공간이 생겼으니 쓰기를 기다리던 봇을 깨움
+        if (ring.takeProducerWaiting()) {
+            channel.notifyClient();
+        }
+        if (conn.closed || channel.decoder().failed() || ring.isCorrupted()) {
             break;
         }
-        
-        if (bytesRead != 4) {
-            std::cerr << "헤더 읽기 실패: " << bytesRead << " 바이트만 읽음" << std::endl;
-            continue;
+        if (!arm || ring.prepareConsumerWait()) {
+            break;
         }
-        
-        // 메시지 길이 계산
-        uint32_t messageSize = 
-            ((uint32_t)headerBuffer[0] << 24) |
-            ((uint32_t)headerBuffer[1] << 16) |
-            ((uint32_t)headerBuffer[2] << 8) |
-            (uint32_t)headerBuffer[3];
-            
-        std::cout << "수신할 메시지 크기: " << messageSize << " 바이트" << std::endl;
-            
-        // 메시지 본문 읽기
-        std::vector<char> messageBuffer(messageSize);
-        bytesRead = recv(clientSocket, messageBuffer.data(), messageSize, 0);
-        
-        if (bytesRead <= 0) {
-            std::cout << "플레이어 " << playerId << " 연결 종료" << std::endl;
-            eventBus.publish("client_disconnected", {{"player_id", playerId}});
-            close(clientSocket);
+    }
+
+    if (frames > 0 && !conn.closed) {
+        conn.lastActivityTick = shard.timers.now();
+        eventBus.publish("client_messages_processed", {{"player_id", conn.playerId}});
+    }
+
+    if (conn.closed) {
+        return frames;
+    }
+    if (channel.decoder().failed() || ring.isCorrupted()) {
+        std::cerr << "플레이어 " << conn.playerId << " 공유 메모리 링 오류 (프레임 크기 초과 또는 잘못된 위치), 연결 종료"
+                  << std::endl;
+        closeConnection(shard, conn);
+        return frames;
+    }
+
+    // 봇이 서버 → 봇 링을 비워 도어벨을 울렸을 수 있으므로 남은 송신도 이어서 처리
+    if (!conn.outbound.empty()) {
+        flushShared(conn);
+    }
+    return frames;
+}
+
+size_t NetworkManager::pollSharedChannels(Shard& shard, bool arm) {
+    // 처리 중 연결이 닫히면 목록이 바뀌므로 복사본을 순회 (닫힌 연결은 루프 반복이 끝날 때까지 해제되지 않음)
+    std::vector<Connection*> connections = shard.sharedConnections;
+    size_t frames = 0;
+    for (Connection* conn : connections) {
+        if (!conn->closed) {
+            frames += pollSharedChannel(shard, *conn, arm);
+        }
+    }
+    return frames;
+}
+
+void NetworkManager::flushShared(Connection& conn) {
+    static const int MAX_SHARED_SPANS = 16;
+
+    SharedMemoryChannel& channel = *conn.sharedChannel;
+    SharedRing& ring = channel.outbound();
+    size_t written = 0;
+
+    while (!conn.outbound.empty()) {
+        iovec spans[MAX_SHARED_SPANS];
+        int count = conn.fillOutboundSpans(spans, MAX_SHARED_SPANS);
+        size_t copied = ring.write(spans, count);
+        conn.consumeOutbound(copied);
+        written += copied;
+
+        if (ring.isCorrupted()) {
+            // 게임 이벤트 처리 도중 플레이어가 제거되지 않도록 종료는 소켓 이벤트에 맡김
+            std::cerr << "플레이어 " << conn.playerId << " 공유 메모리 링 위치 손상, 연결 종료" << std::endl;
+            shutdown(conn.socket, SHUT_RDWR);
+            return;
+        }
+        // 링이 가득 차면 봇이 읽은 뒤 도어벨을 울리도록 표시하고 중단
+        if (copied == 0 && ring.prepareProducerWait()) {
             break;
         }
-        
-        if (bytesRead != messageSize) {
-            std::cerr << "메시지 읽기 실패: " << bytesRead << "/" << messageSize << " 바이트만 읽음" << std::endl;
-            continue;
+    }
+
+    if (written > 0 && ring.takeConsumerWaiting()) {
+        channel.notifyClient();
+    }
+    updateBackpressure(conn);
+}
+
+void NetworkManager::dispatchMessage(Shard& shard, Connection& conn, const char* messageData, size_t length,
+                                     int64_t nowNs) {
+    int playerId = conn.playerId;
+    int clientSocket = conn.socket;
+
+    try {
+        MessageData msg = unpackMessage(messageData, length);
+        if (config.verboseLog) {
+            std::cout << "플레이어 " << playerId << " 수신 (" << length << " 바이트): " << msg.dump() << std::endl;
         }
         
-        try {
-            std::string messageData(messageBuffer.data(), messageSize);
-            std::cout << "수신된 원시 데이터 크기: " << messageData.size() << " 바이트" << std::endl;
-            std::cout << "원시 데이터 헥사값: ";
-            for (size_t i = 0; i < std::min(messageSize, (uint32_t)32); ++i) {
-                printf("%02x ", (unsigned char)messageBuffer[i]);
+        // 메시지 타입 확인 전에 키 존재 여부 검사
+        if (!msg.contains("type")) {
+            std::cerr << "잘못된 메시지 형식: 'type' 필드가 없습니다." << std::endl;
+            std::cerr << "전체 메시지 내용: " << msg.dump() << std::endl;
+            return;
+        }
+
+        std::string messageType = msg["type"].stringValue;
+
+        // 하트비트와 지연 측정은 네트워크 계층에서 처리 (수신 시각은 이미 갱신됨)
+        if (messageType == "pong") {
+            handlePong(conn, msg);
+            return;
+        }
+        if (messageType == "ping") {
+            // 클라이언트도 같은 방식으로 RTT와 시계 오차를 잴 수 있도록 보낸 시각을 돌려주고 서버 시각을 실음
+            MessageData pong;
+            pong["type"] = "pong";
+            if (msg.contains("client_time")) {
+                pong["client_time"] = msg["client_time"];
             }
-            std::cout << std::endl;
-            
-            MessageData msg = unpackMessage(messageData);
-            std::cout << "언패킹된 데이터: " << msg.dump() << std::endl;
-            
-            // 메시지 타입 확인 전에 키 존재 여부 검사
-            if (!msg.contains("type")) {
-                std::cerr << "잘못된 메시지 형식: 'type' 필드가 없습니다." << std::endl;
-                std::cerr << "전체 메시지 내용: " << msg.dump() << std::endl;
-                continue;
+            pong["server_time"] = wallClockUs();
+            sendToPlayer(playerId, packMessage(pong));
+            return;
+        }
+        
+        // 로컬 봇: 이후 프레임을 공유 메모리 링으로 주고받도록 전환
+        if (messageType == "shm_attach") {
+            attachSharedMemory(shard, conn);
+            return;
+        }
+
+        // 방 이동 관리 명령 (room_export/room_import/room_commit/room_resume/room_assign)
+        if (messageType.rfind("room_", 0) == 0) {
+            roomRouter->handleCommand(playerId, conn.adminPeer, messageType, msg, [this, &shard]() {
+                return allocatePlayerId(shard);
+            });
+            return;
+        }
+
+        // 재연결: 끊긴 세션의 플레이어로 이 연결을 옮김
+        if (messageType == "resume") {
+            resumeSession(shard, conn, msg);
+            return;
+        }
+
+        // connect 타입 메시지 처리
+        if (messageType == "connect") {
+            std::cout << "새로운 클라이언트 연결 요청" << std::endl;
+
+            // 다른 노드가 맡은 방이면 그 노드로 안내 (이 노드에는 플레이어를 만들지 않음)
+            std::string room = msg.contains("room") ? msg["room"].stringValue : "";
+            if (!room.empty() && !roomRouter->isLocal(room)) {
+                roomRouter->redirect(playerId, room);
+                return;
             }
 
-            std::string messageType = msg["type"].stringValue;
-            
-            // connect 타입 메시지 처리
-            if (messageType == "connect") {
-                std::cout << "새로운 클라이언트 연결 요청" << std::endl;
-                
-                // 플레이어 ID와 소켓 정보를 포함하여 이벤트 발행
-                MessageData connectData;
-                connectData["type"] = "player_connect";
-                connectData["player_id"] = playerId;
-                connectData["socket"] = clientSocket;
-                if (msg.contains("nickname")) {
-                    connectData["nickname"] = msg["nickname"];
-                }
-                
-                eventBus.publish("player_connect", connectData);
-                continue;
+            // 수락 때 미뤄 둔 플레이어 생성 (connect_response는 player_added 처리에서 전송)
+            if (!conn.handshaken) {
+                conn.handshaken = true;
+                pendingHandshakes--;
+                eventBus.publish("client_connected", {
+                    {"player_id", playerId},
+                    {"socket", clientSocket}
+                });
+                printf("클라이언트 연결 이벤트 발행\n");
             }
             
-            // 플레이어 ID 추가
-            msg["player_id"] = playerId;
+            // 플레이어 ID와 소켓 정보를 포함하여 이벤트 발행
+            MessageData connectData;
+            connectData["type"] = "player_connect";
+            connectData["player_id"] = playerId;
+            connectData["socket"] = clientSocket;
+            if (msg.contains("nickname")) {
+                connectData["nickname"] = msg["nickname"];
+            }
+            if (!room.empty()) {
+                connectData["room"] = room;
+            }
             
-            // 클라이언트 메시지 수신 이벤트 발행
-            eventBus.publish("client_message_received", msg);
+            eventBus.publish("player_connect", connectData);
+            return;
         }
-        catch (const std::exception& e) {
-            std::cerr << "메시지 파싱 오류: " << e.what() << std::endl;
-            std::cerr << "메시지 크기: " << messageSize << " 바이트" << std::endl;
-            // 디버깅을 위해 원시 데이터의 첫 몇 바이트를 16진수로 출력
-            std::cerr << "원시 데이터 미리보기: ";
-            for (size_t i = 0; i < std::min(messageSize, (uint32_t)16); ++i) {
-                std::cerr << std::hex << (int)(unsigned char)messageBuffer[i] << " ";
+        
+        // connect 전에는 플레이어가 없으므로 게임 입력을 버림
+        if (!conn.handshaken) {
+            std::cerr << "플레이어 " << playerId << " connect 전 입력 무시: " << messageType << std::endl;
+            return;
+        }
+
+        // 속도 제한은 게임 입력에만 적용 (하트비트, 핸드셰이크, 관리 명령은 위에서 이미 처리되어 버려지지 않음)
+        if (!takeInputToken(conn, nowNs)) {
+            return;
+        }
+
+        // 플레이어 ID 추가
+        msg["player_id"] = playerId;
+        
+        // 클라이언트 메시지 수신 이벤트 발행
+        eventBus.publish("client_message_received", msg);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "메시지 파싱 오류: " << e.what() << std::endl;
+        std::cerr << "메시지 크기: " << length << " 바이트" << std::endl;
+        // 디버깅을 위해 원시 데이터의 첫 몇 바이트를 16진수로 출력
+        std::cerr << "원시 데이터 미리보기: ";
+        for (size_t i = 0; i < std::min(length, size_t(16)); ++i) {
+            std::cerr << std::hex << (int)(unsigned char)messageData[i] << " ";
+        }
+        std::cerr << std::dec << std::endl;
+    }
+}
+
+void NetworkManager::pushFrame(Shard& shard, PendingFrame pending) {
+    // 샤드 자신의 스레드면 바로 송신 큐에 넣되, 먼저 넘어와 있던 프레임부터 처리해 순서를 지킴
+    if (currentShard == &shard) {
+        drainInbox(shard);
+        deliverPending(shard, pending);
+        return;
+    }
+
+    bool wasEmpty;
+    {
+        std::lock_guard<std::mutex> lock(shard.inboxMutex);
+        wasEmpty = shard.inbox.empty();
+        shard.inbox.push_back(std::move(pending));
+    }
+    if (wasEmpty) {
+        Shard* target = &shard;
+        shard.eventLoop.post([this, target]() {
+            drainInbox(*target);
+        });
+    }
+}
+
+void NetworkManager::drainInbox(Shard& shard) {
+    std::vector<PendingFrame> pendingFrames;
+    {
+        std::lock_guard<std::mutex> lock(shard.inboxMutex);
+        pendingFrames.swap(shard.inbox);
+    }
+
+    for (const auto& pending : pendingFrames) {
+        deliverPending(shard, pending);
+    }
+}
+
+void NetworkManager::deliverPending(Shard& shard, const PendingFrame& pending) {
+    if (pending.socket < 0) {
+        // connect 전 연결은 아직 게임에 참여하지 않았으므로 첫 응답이 connect_response가 되도록 건너뜀
+        for (auto& item : shard.connections) {
+            if (item.second->handshaken) {
+                enqueueFrame(shard, *item.second, pending.frame);
             }
-            std::cerr << std::dec << std::endl;
         }
+        return;
+    }
+
+    // 그사이 연결이 닫히고 소켓 번호가 재사용됐을 수 있으므로 플레이어 ID까지 확인
+    auto it = shard.connections.find(pending.socket);
+    if (it == shard.connections.end() || it->second->playerId != pending.playerId) {
+        return;
+    }
+    enqueueFrame(shard, *it->second, pending.frame);
+}
+
+void NetworkManager::enqueueFrame(Shard& shard, Connection& conn, const FramePtr& frame) {
+    if (conn.closed) {
+        return;
+    }
+
+    conn.outboundBytes += frame->size();
+    conn.outbound.push_back(frame);
+
+    if (conn.outboundBytes > config.outboundMaxBytes) {
+        // 너무 느린 클라이언트는 끊음. 종료 처리는 수신 쪽 이벤트에서 진행되므로
+        // 게임 이벤트 처리 도중 플레이어가 제거되지 않음
+        std::cerr << "플레이어 " << conn.playerId << " 송신 큐 초과 (" << conn.outboundBytes
+                  << " 바이트), 연결 종료" << std::endl;
+        shutdown(conn.socket, SHUT_RDWR);
+        return;
+    }
+
+    updateBackpressure(conn);
+    if (conn.sharedChannel) {
+        flushShared(conn);
+    } else {
+        shard.backend->flush(conn);
+    }
+}
+
+void NetworkManager::updateBackpressure(Connection& conn) {
+    if (conn.closed) {
+        return;
+    }
+
+    // 상위/하위 워터마크로 게임 계층에 송신 지연을 알림 (블로킹하지 않음)
+    if (!conn.congested && conn.outboundBytes > config.outboundHighWatermark) {
+        conn.congested = true;
+        congestedConnections++;
+        std::cout << "플레이어 " << conn.playerId << " 송신 큐 혼잡: " << conn.outboundBytes << " 바이트" << std::endl;
+        eventBus.publish("client_backpressure", {
+            {"player_id", conn.playerId},
+            {"congested", true}
+        });
+    }
+    else if (conn.congested && conn.outboundBytes <= config.outboundLowWatermark) {
+        conn.congested = false;
+        congestedConnections--;
+        std::cout << "플레이어 " << conn.playerId << " 송신 큐 혼잡 해소" << std::endl;
+        eventBus.publish("client_backpressure", {
+            {"player_id", conn.playerId},
+            {"congested", false}
+        });
+    }
+}
+
+void NetworkManager::closeConnection(Shard& shard, Connection& conn) {
+    if (conn.closed) {
+        return;
+    }
+    conn.closed = true;
+
+    connectionCount--;
+    if (!conn.handshaken) {
+        pendingHandshakes--;
+    }
+    if (conn.congested) {
+        congestedConnections--;
+    }
+
+    int playerId = conn.playerId;
+    int clientSocket = conn.socket;
+
+    std::cout << "플레이어 " << playerId << " 연결 종료" << std::endl;
+    if (conn.droppedInputs > 0) {
+        std::cout << "플레이어 " << playerId << " 속도 제한으로 버린 입력: " << conn.droppedInputs << "개" << std::endl;
+    }
+    if (conn.latency.samples > 0) {
+        std::cout << "플레이어 " << playerId << " RTT " << conn.latency.smoothedRttUs / 1000.0 << "ms (최소 "
+                  << conn.latency.minRttUs / 1000.0 << "ms), 지터 " << conn.latency.jitterUs / 1000.0
+                  << "ms, 시계 오차 " << conn.latency.clockOffsetUs / 1000.0 << "ms" << std::endl;
+    }
+    shard.timers.cancel(conn.heartbeatTimer);
+    if (conn.sharedChannel) {
+        shard.eventLoop.removeFd(conn.sharedChannel->serverDoorbell());
+        auto shared = std::find(shard.sharedConnections.begin(), shard.sharedConnections.end(), &conn);
+        if (shared != shard.sharedConnections.end()) {
+            shard.sharedConnections.erase(shared);
+        }
+    }
+    shard.backend->removeConnection(conn);
+    if (conn.zeroCopyPending.empty()) {
+        close(clientSocket);
+    } else {
+        // 커널이 아직 보낸 프레임의 페이지를 읽고 있음. 완료 알림은 소켓을 닫으면 받을 수 없으므로
+        // 연결만 끊고 소켓은 recycleConnections에서 zeroCopyClosing으로 넘겨 완료 후에 닫음
+        shutdown(clientSocket, SHUT_RDWR);
+    }
+    if (conn.busyPoll) {
+        updateBusyPoll(shard, -1);
+    }
+
+    // 현재 이벤트 처리 중 참조가 남아 있을 수 있으므로 슬롯 반납은 루프 반복이 끝난 뒤에
+    auto it = shard.connections.find(clientSocket);
+    shard.closedConnections.push_back(std::move(it->second));
+    shard.connections.erase(it);
+
+    // 재연결 토큰이 있으면 바로 제거하지 않고 유예 시간 동안 상태를 보관
+    bool superseded = false;
+    bool suspended = false;
+    {
+        std::lock_guard<std::mutex> lock(routeMutex);
+        auto route = playerRoutes.find(playerId);
+        if (route == playerRoutes.end() || route->second.shard != &shard || route->second.socket != clientSocket) {
+            // 다른 연결이 이미 resume으로 이 플레이어를 넘겨받음
+            superseded = true;
+        } else {
+            playerRoutes.erase(route);
+            suspended = sessions->suspend(playerId);
+        }
+    }
+
+    if (superseded) {
+        return;
+    }
+    if (suspended) {
+        std::cout << "플레이어 " << playerId << " 재연결 대기 (" << config.sessionGraceMs << "ms)" << std::endl;
+        eventBus.publish("client_suspended", {{"player_id", playerId}});
+        return;
+    }
+    if (!conn.handshaken) {
+        // connect 전에 끊긴 연결은 게임 계층에 플레이어가 없음
+        return;
     }
+
+    eventBus.publish("client_disconnected", {{"player_id", playerId}});
 }
 
 void NetworkManager::sendToPlayer(int playerId, const std::string& message) {
-    // 플레이어 소켓 요청 이벤트 발행
-    eventBus.publish("request_player_info", {
-        {"action", "get_player_socket"},
-        {"player_id", playerId},
-        {"message", message}
-    });
+    sendFrame(playerId, makeFrame(message));
+}
+
+void NetworkManager::sendFrame(int playerId, const FramePtr& frame) {
+    // 플레이어 연결을 소유한 샤드의 송신 큐에 추가 (실제 전송은 소켓이 쓰기 가능할 때 백엔드가 수행)
+    PlayerRoute route;
+    {
+        std::lock_guard<std::mutex> lock(routeMutex);
+        auto it = playerRoutes.find(playerId);
+        if (it == playerRoutes.end()) {
+            std::cerr << "메시지 전송 실패: 연결되지 않은 플레이어 " << playerId << std::endl;
+            return;
+        }
+        route = it->second;
+    }
+
+    if (config.verboseLog) {
+        std::cout << "플레이어 " << playerId << "에게 메시지 전송: " << frame->size() << " 바이트" << std::endl;
+    }
+    pushFrame(*route.shard, PendingFrame{playerId, route.socket, frame});
 }
 
 void NetworkManager::broadcastGameState(const MessageData& gameState) {
     MessageData enhancedState = gameState;
     enhancedState["type"] = "game_state_update";
     
-    std::string packedMsg = packMessage(enhancedState);
-    
-    std::cout << "게임 상태 브로드캐스트" << std::endl;
-    
-    // 플레이어 정보 요청 이벤트 발행
-    eventBus.publish("request_player_info", {
-        {"action", "get_all_players"},
-        {"game_state", enhancedState}
+    // 한 번만 인코딩하고 모든 연결의 송신 큐에 같은 프레임을 넣음
+    broadcastFrame(makeFrame(packMessage(enhancedState)));
+}
+
+void NetworkManager::broadcastFrame(const FramePtr& frame) {
+    if (config.verboseLog) {
+        std::cout << "게임 상태 브로드캐스트: " << frame->size() << " 바이트" << std::endl;
+    }
+
+    for (auto& shard : shards) {
+        pushFrame(*shard, PendingFrame{0, -1, frame});
+    }
+}
+
+void NetworkManager::disconnectPlayer(int playerId) {
+    // 세션을 먼저 폐기해야 연결 종료가 재연결 대기가 아닌 제거로 처리됨
+    PlayerRoute route;
+    {
+        std::lock_guard<std::mutex> lock(routeMutex);
+        sessions->revoke(playerId);
+        auto it = playerRoutes.find(playerId);
+        if (it == playerRoutes.end()) {
+            return;
+        }
+        route = it->second;
+    }
+
+    // 연결은 소유한 샤드의 스레드에서만 닫을 수 있음
+    route.shard->eventLoop.post([this, route, playerId]() {
+        Shard& shard = *route.shard;
+        auto it = shard.connections.find(route.socket);
+        if (it != shard.connections.end() && it->second->playerId == playerId) {
+            closeConnection(shard, *it->second);
+        }
     });
 }
 
 NetworkManager::~NetworkManager() {
-    close(listenSocket);
+    stop();
+    for (auto& shard : shards) {
+        if (shard->thread.joinable()) {
+            shard->thread.join();
+        }
+    }
+
+    // 후임 프로세스에 넘겼거나 넘겨받다 그만둔 경우 다른 프로세스가 같은 경로를 쓰고 있으므로 지우지 않음
+    if (unixListenSocket >= 0) {
+        close(unixListenSocket);
+        if (config.unixPath[0] != '@' && !handoff.handedOff() && !handoff.takeoverAbandoned()) {
+            unlink(config.unixPath.c_str());
+        }
+    }
+    handoff.closeListener();
 }
 
-void NetworkManager::acceptClient() {
-    sockaddr_in clientAddr;
-    socklen_t clientLen = sizeof(clientAddr);
-    
-    int clientSocket = accept(listenSocket, (struct sockaddr*)&clientAddr, &clientLen);
-    if (clientSocket < 0) {
-        std::cout << "클라이언트 연결 수락 실패" << std::endl;
+void NetworkManager::startHeartbeat(Shard& shard, Connection& conn) {
+    if (config.heartbeatIntervalMs > 0 || config.idleTimeoutMs > 0 || config.rttProbeIntervalMs > 0) {
+        Connection* connection = &conn;
+        connection->lastActivityTick = shard.timers.now();
+        connection->lastPingTick = connection->lastActivityTick;
+        connection->heartbeatTimer.onExpire = [this, &shard, connection]() {
+            checkHeartbeat(shard, *connection);
+        };
+        checkHeartbeat(shard, *connection);
+    }
+}
+
+void NetworkManager::completeTakeover() {
+    const MessageData& state = handoff.takenState();
+
+    // 세션과 게임 상태를 먼저 복원해야 넘겨받은 연결의 입력을 바로 처리할 수 있음
+    sessions->restore(state["sessions"]);
+    eventBus.publish("game_restore", state["game"]);
+
+    // 연결은 샤드에 고르게 나눠 붙임 (이전 프로세스에서 어느 샤드였는지는 상관없음)
+    std::unordered_set<int> connected;
+    size_t next = 0;
+    for (const MessageData& connection : state["connections"].arrayValue) {
+        Shard& shard = *shards[next++ % shards.size()];
+        adoptConnection(shard, connection, handoff.inherited(connection["fd"]));
+        connected.insert(static_cast<int>(connection["player_id"].intValue));
+    }
+
+    // 연결을 넘겨받지 못한 플레이어 (공유 메모리 봇 등)는 끊긴 것으로 처리
+    for (const auto& [id, player] : state["game"]["players"].objectValue) {
+        int playerId = std::stoi(id);
+        if (connected.count(playerId) || player["suspended"].boolValue) {
+            continue;
+        }
+        bool suspended;
+        {
+            std::lock_guard<std::mutex> lock(routeMutex);
+            suspended = sessions->suspend(playerId);
+        }
+        eventBus.publish(suspended ? "client_suspended" : "client_disconnected", {{"player_id", playerId}});
+    }
+
+    std::cout << "이전 프로세스에서 연결 " << state["connections"].size() << "개, 세션 " << state["sessions"].size()
+              << "개 넘겨받음" << std::endl;
+    // 확정받지 못하면 이전 프로세스가 같은 소켓으로 서비스를 재개하므로 아무것도 보내지 않고 종료
+    // (샤드가 정리되면서 넘겨받은 fd만 닫힘)
+    if (!handoff.finishTakeover()) {
+        throw std::runtime_error("넘겨받기 실패, 이전 프로세스가 서비스를 계속함");
+    }
+
+    if (!config.handoffPath.empty()) {
+        openHandoffListener();
+    }
+}
+
+void NetworkManager::adoptConnection(Shard& shard, const MessageData& state, int socket) {
+    int playerId = static_cast<int>(state["player_id"].intValue);
+    auto conn = std::make_unique<Connection>(socket, playerId, &shard.bufferPool, config.maxFrameSize);
+    handoff.restoreConnection(state, *conn);
+
+    connectionCount++;
+    if (!conn->handshaken) {
+        pendingHandshakes++;
+    }
+    Connection* connection = conn.get();
+    shard.connections[socket] = std::move(conn);
+    {
+        std::lock_guard<std::mutex> lock(routeMutex);
+        playerRoutes[playerId] = PlayerRoute{&shard, socket};
+    }
+
+    // 백엔드 등록부터는 수락한 연결과 같이 리액터 스레드에서 진행
+    shard.eventLoop.post([this, &shard, connection]() {
+        shard.backend->addConnection(*connection);
+        if (connection->busyPoll) {
+            updateBusyPoll(shard, 1);
+        }
+        startHeartbeat(shard, *connection);
+        if (!connection->outbound.empty()) {
+            shard.backend->flush(*connection);
+        }
+        if (!connection->inbound.empty()) {
+            handleClientMessages(shard, *connection);
+        }
+    });
+}
+
+void NetworkManager::openHandoffListener() {
+    // 후임 프로세스가 접속하면 리액터를 모두 멈추고 run()에서 상태를 넘김
+    handoff.openListener(shards[0]->eventLoop, [this]() {
+        stop();
+    });
+}
+
+bool NetworkManager::handOff() {
+    // 리액터가 모두 멈췄으므로 이 스레드에서 다른 샤드로 넘어가던 프레임까지 송신 큐에 반영
+    for (auto& shard : shards) {
+        drainInbox(*shard);
+    }
+
+    gameSnapshot = MessageData();
+    eventBus.publish("game_snapshot_request");
+
+    MessageData state;
+    state["reactors"] = static_cast<int>(shards.size());
+    state["port"] = config.port;
+    state["busy_poll_port"] = config.busyPollPort;
+    state["unix_path"] = config.unixPath;
+    state["player_id_cursor"] = playerIds.nextUnallocated();
+    MessageData listeners;
+    listeners.type = MessageData::Array;
+    for (auto& shard : shards) {
+        MessageData sockets;
+        sockets.push_back(handoff.pass(shard->listenSocket));
+        sockets.push_back(handoff.pass(shard->busyPollListenSocket));
+        listeners.push_back(sockets);
+    }
+    state["listeners"] = listeners;
+    state["unix_listener"] = handoff.pass(unixListenSocket);
+
+    MessageData connections;
+    connections.type = MessageData::Array;
+    for (auto& shard : shards) {
+        for (auto& item : shard->connections) {
+            // 공유 메모리 봇은 매핑을 넘길 수 없으므로 다시 접속하게 함
+            const Connection& conn = *item.second;
+            if (conn.closed || conn.sharedChannel) {
+                continue;
+            }
+            connections.push_back(handoff.saveConnection(conn));
+        }
+    }
+    state["connections"] = connections;
+    state["sessions"] = sessions->save();
+    state["game"] = gameSnapshot;
+
+    return handoff.handOff(state);
+}
+
+void NetworkManager::run() {
+    if (handoff.takingOver()) {
+        completeTakeover();
+    }
+
+    while (true) {
+        // 첫 번째 샤드는 호출한 스레드에서, 나머지는 전용 스레드에서 실행
+        for (size_t i = 1; i < shards.size(); ++i) {
+            Shard* shard = shards[i].get();
+            shard->thread = std::thread([this, shard]() {
+                runShard(*shard);
+            });
+        }
+
+        runShard(*shards[0]);
+
+        for (auto& shard : shards) {
+            if (shard->thread.joinable()) {
+                shard->thread.join();
+            }
+        }
+
+        // 후임 프로세스가 접속해 멈춘 경우 상태를 넘기고 종료 (실패하면 같은 연결로 다시 서비스)
+        if (!handoff.successorWaiting() || handOff()) {
+            break;
+        }
+        running = true;
+    }
+}
+
+void NetworkManager::runShard(Shard& shard) {
+    currentShard = &shard;
+    while (running) {
+        // busy-poll 연결이 있으면 이벤트가 끊긴 뒤 spin 예산만큼 논블로킹으로 계속 확인해
+        // 커널에서 잠들었다 깨어나는 지연 없이 다음 입력을 바로 처리
+        if (shard.busyPollConnections > 0 && config.busySpinUs > 0) {
+            int64_t spinNs = config.busySpinUs * 1000LL;
+            int64_t idleSince = monotonicNs();
+            while (running && shard.busyPollConnections > 0) {
+                int handled = shard.backend->runOnce(0);
+                handled += pollSharedChannels(shard, false);
+                recycleConnections(shard);
+
+                int64_t now = monotonicNs();
+                if (handled > 0) {
+                    idleSince = now;
+                } else if (now - idleSince >= spinNs) {
+                    break;
+                }
+            }
+        }
+
+        // 잠들기 전에 공유 메모리 링을 비우고 봇에게 도어벨을 요청 (스핀 중에는 요청하지 않음)
+        if (!shard.sharedConnections.empty()) {
+            pollSharedChannels(shard, true);
+        }
+
+        shard.backend->runOnce(-1);
+        recycleConnections(shard);
+    }
+    currentShard = nullptr;
+}
+
+int NetworkManager::allocatePlayerId(Shard& shard) {
+    // ID 범위를 한 바퀴 돌았으면 아직 연결되어 있거나 재연결을 기다리는 플레이어의 ID는 건너뜀
+    std::lock_guard<std::mutex> lock(routeMutex);
+    int playerId;
+    do {
+        playerId = playerIds.allocate(shard.idBlock);
+    } while (playerRoutes.count(playerId) || sessions->contains(playerId));
+    return playerId;
+}
+
+std::unique_ptr<Connection> NetworkManager::acquireConnection(Shard& shard, int socket, int playerId) {
+    if (shard.freeConnections.empty()) {
+        return std::make_unique<Connection>(socket, playerId, &shard.bufferPool, config.maxFrameSize);
+    }
+    std::unique_ptr<Connection> conn = std::move(shard.freeConnections.back());
+    shard.freeConnections.pop_back();
+    conn->socket = socket;
+    conn->playerId = playerId;
+    return conn;
+}
+
+void NetworkManager::recycleConnections(Shard& shard) {
+    // 닫힌 연결은 상태를 비워 빈 슬롯으로 되돌림 (한도를 넘는 몫만 해제)
+    // zerocopy 완료 알림을 기다리는 연결은 프레임을 놓으면 커널이 해제된 메모리를 읽게 되므로 따로 보관
+    for (auto& conn : shard.closedConnections) {
+        if (!conn->zeroCopyPending.empty()) {
+            shard.zeroCopyClosing.emplace_back(monotonicMs() + ZEROCOPY_LINGER_MS, std::move(conn));
+            if (!shard.zeroCopyTimer.scheduled()) {
+                Shard* closing = &shard;
+                shard.zeroCopyTimer.onExpire = [this, closing]() {
+                    closeZeroCopyConnections(*closing);
+                };
+                shard.timers.schedule(shard.zeroCopyTimer, 1);
+            }
+            continue;
+        }
+        if (shard.freeConnections.size() < MAX_FREE_CONNECTIONS) {
+            conn->reset(-1, -1);
+            shard.freeConnections.push_back(std::move(conn));
+        }
+    }
+    shard.closedConnections.clear();
+}
+
+void NetworkManager::closeZeroCopyConnections(Shard& shard) {
+    int64_t now = monotonicMs();
+    auto& closing = shard.zeroCopyClosing;
+    for (size_t i = 0; i < closing.size();) {
+        Connection& conn = *closing[i].second;
+        shard.backend->reapZeroCopyCompletions(conn);
+        if (!conn.zeroCopyPending.empty() && now < closing[i].first) {
+            ++i;
+            continue;
+        }
+        if (!conn.zeroCopyPending.empty()) {
+            // 상대가 받지 않아 전송이 끝나지 않음. RST로 닫아 커널이 송신 큐를 버린 뒤에 프레임을 놓음
+            std::cerr << "플레이어 " << conn.playerId << " zerocopy 완료 대기 시간 초과 ("
+                      << conn.zeroCopyPending.size() << "개), 강제 종료" << std::endl;
+            linger abort{1, 0};
+            setsockopt(conn.socket, SOL_SOCKET, SO_LINGER, &abort, sizeof(abort));
+        }
+        close(conn.socket);
+        closing[i] = std::move(closing.back());
+        closing.pop_back();
+    }
+    if (!closing.empty()) {
+        shard.timers.schedule(shard.zeroCopyTimer, 1);
+    }
+}
+
+void NetworkManager::stop() {
+    running = false;
+    // 대기 중인 리액터를 깨워 루프 조건을 다시 확인하게 함
+    for (auto& shard : shards) {
+        shard->eventLoop.post([]() {});
+    }
+}
+
+void NetworkManager::drain(int timeoutMs) {
+    if (draining.exchange(true)) {
         return;
     }
 
-    static int nextPlayerId = 1;
-    int playerId = nextPlayerId++;
+    shards[0]->eventLoop.post([this, timeoutMs]() {
+        std::cout << "드레인 시작: 새 연결 거절, 진행 중인 게임 " << activeGames() << "개 대기 (최대 " << timeoutMs
+                  << "ms)" << std::endl;
+        // 종료할 프로세스에 후임이 붙지 않도록 무중단 재시작 대기도 멈춤
+        handoff.closeListener();
 
-    // 클라이언트 연결 이벤트 발행
-    eventBus.publish("client_connected", {
-        {"player_id", playerId},
-        {"socket", clientSocket}
+        MessageData notice;
+        notice["type"] = "server_draining";
+        notice["deadline_ms"] = timeoutMs;
+        broadcastFrame(makeFrame(packMessage(notice)));
+
+        drainDeadlineMs = monotonicMs() + timeoutMs;
+        drainTimer.onExpire = [this]() {
+            checkDrain();
+        };
+        checkDrain();
     });
-    printf("클라이언트 연결 이벤트 발행\n");
-    // 클라이언트 메시지 처리 스레드 시작
-    std::thread([this, playerId, clientSocket]() {
-        this->handleClientMessages(playerId, clientSocket);
-    }).detach();
-} 
\ No newline at end of file
+}
+
+int NetworkManager::activeGames() {
+    std::lock_guard<std::mutex> lock(routeMutex);
+    int active = 0;
+    for (const auto& [playerId, route] : playerRoutes) {
+        if (!finishedPlayers.count(playerId)) {
+            active++;
+        }
+    }
+    // connect 전인 연결(관리 도구, 핸드셰이크 대기)은 게임이 아님
+    return std::max(0, active - pendingHandshakes.load());
+}
+
+void NetworkManager::checkDrain() {
+    Shard& shard = *shards[0];
+    int active = activeGames();
+    int64_t now = monotonicMs();
+    if (active > 0 && now < drainDeadlineMs) {
+        shard.timers.schedule(drainTimer, shard.timers.toTicks(DRAIN_CHECK_MS));
+        return;
+    }
+
+    if (active > 0) {
+        std::cout << "드레인 마감 시각 도달, 진행 중인 게임 " << active << "개를 남기고 종료" << std::endl;
+    } else {
+        std::cout << "진행 중인 게임 없음, 종료" << std::endl;
+    }
+
+    // 결과 기록 등 종료 처리는 입력을 받지 않게 한 뒤 한 번만
+    shuttingDown = true;
+    eventBus.publish("server_shutdown");
+
+    MessageData notice;
+    notice["type"] = "server_shutdown";
+    broadcastFrame(makeFrame(packMessage(notice)));
+
+    // 각 샤드가 안내까지 보낸 뒤 연결을 닫아 나가면 리액터를 멈춤
+    shutdownDeadlineMs = now + SHUTDOWN_FLUSH_MS;
+    for (auto& target : shards) {
+        Shard* flushing = target.get();
+        flushing->shutdownTimer.onExpire = [this, flushing]() {
+            flushForShutdown(*flushing);
+        };
+        flushing->eventLoop.post([this, flushing]() {
+            flushForShutdown(*flushing);
+        });
+    }
+}
+
+void NetworkManager::flushForShutdown(Shard& shard) {
+    // 송신 큐를 다 보낸 연결은 FIN을 보내고 클라이언트가 닫기를 기다림
+    // (받지 않은 데이터가 남은 채로 닫으면 RST가 나가 클라이언트가 아직 읽지 않은 안내가 버려질 수 있음)
+    bool pending = false;
+    for (auto& item : shard.connections) {
+        Connection& conn = *item.second;
+        if (conn.closed) {
+            continue;
+        }
+        pending = true;
+        if (conn.outboundBytes == 0) {
+            shutdown(conn.socket, SHUT_WR);
+        }
+    }
+
+    if (pending && monotonicMs() < shutdownDeadlineMs) {
+        shard.timers.schedule(shard.shutdownTimer, shard.timers.toTicks(TIMER_TICK_MS));
+        return;
+    }
+    if (++flushedShards == static_cast<int>(shards.size())) {
+        std::cout << "송신 큐 정리 완료, 리액터 정지" << std::endl;
+        stop();
+    }
+}
+
+const char* NetworkManager::checkAdmission(Shard& shard) {
+    if (draining) {
+        return "draining";
+    }
+    if (config.maxConnections > 0 && connectionCount >= config.maxConnections) {
+        return "max_connections";
+    }
+    if (config.maxPendingHandshakes > 0 && pendingHandshakes >= config.maxPendingHandshakes) {
+        return "too_many_handshakes";
+    }
+    // 기존 플레이어에게 보낼 데이터가 밀려 있거나 리액터가 포화 상태면 새 연결을 받지 않음
+    if (config.maxCongestedConnections > 0 && congestedConnections >= config.maxCongestedConnections) {
+        return "overloaded";
+    }
+    if (config.maxReactorLoad > 0 && sampleReactorLoad(shard) >= config.maxReactorLoad) {
+        return "overloaded";
+    }
+    return nullptr;
+}
+
+double NetworkManager::sampleReactorLoad(Shard& shard) {
+    static const int64_t SAMPLE_INTERVAL_NS = 500 * 1000 * 1000;
+
+    timespec now;
+    timespec cpu;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu);
+    int64_t nowNs = now.tv_sec * 1000000000LL + now.tv_nsec;
+    int64_t cpuNs = cpu.tv_sec * 1000000000LL + cpu.tv_nsec;
+
+    // 구간 동안 리액터 스레드가 사용한 CPU 시간의 비율
+    if (shard.lastLoadSampleNs == 0) {
+        shard.lastLoadSampleNs = nowNs;
+        shard.lastCpuTimeNs = cpuNs;
+    } else if (nowNs - shard.lastLoadSampleNs >= SAMPLE_INTERVAL_NS) {
+        shard.cpuLoad = static_cast<double>(cpuNs - shard.lastCpuTimeNs) / (nowNs - shard.lastLoadSampleNs);
+        shard.lastLoadSampleNs = nowNs;
+        shard.lastCpuTimeNs = cpuNs;
+    }
+    return shard.cpuLoad;
+}
+
+void NetworkManager::rejectClient(int clientSocket, const char* reason) {
+    // 연결 상태를 만들지 않고 한 번의 논블로킹 send로 알린 뒤 바로 닫음
+    MessageData busy;
+    busy["type"] = "server_busy";
+    busy["reason"] = reason;
+    std::string frame = packMessage(busy);
+
+    ssize_t sent = send(clientSocket, frame.data(), frame.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+    (void)sent;
+    close(clientSocket);
+}
+
+void NetworkManager::handleAcceptError(Shard& shard, int listenSocket, int error) {
+    if (error != EMFILE && error != ENFILE) {
+        std::cout << "클라이언트 연결 수락 실패: " << strerror(error) << std::endl;
+        return;
+    }
+
+    // fd가 없으면 대기 연결이 백로그에 계속 남아 accept가 헛돌게 됨.
+    // 예비 fd를 잠시 반납하고 대기 연결을 하나씩 받아 거절한 뒤 다시 확보
+    int rejected = 0;
+    while (shard.spareFd >= 0) {
+        close(shard.spareFd);
+        int clientSocket = accept4(listenSocket, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (clientSocket >= 0) {
+            rejectClient(clientSocket, "fd_exhausted");
+            rejected++;
+        }
+        shard.spareFd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+        if (clientSocket < 0) {
+            break;
+        }
+    }
+
+    std::cerr << "파일 디스크립터 고갈 (" << strerror(error) << "): 대기 연결 " << rejected
+              << "개 거절" << std::endl;
+}
+
+void NetworkManager::acceptClient(Shard& shard, int listenSocket, int clientSocket) {
+    const char* rejectReason = checkAdmission(shard);
+    if (rejectReason) {
+        std::cout << "새 연결 거절: " << rejectReason << std::endl;
+        rejectClient(clientSocket, rejectReason);
+        return;
+    }
+    connectionCount++;
+    pendingHandshakes++;
+
+    int playerId = allocatePlayerId(shard);
+
+    std::unique_ptr<Connection> conn = acquireConnection(shard, clientSocket, playerId);
+    if (listenSocket == unixListenSocket) {
+        conn->unixSocket = true;
+        ucred credentials{};
+        socklen_t length = sizeof(credentials);
+        conn->adminPeer = getsockopt(clientSocket, SOL_SOCKET, SO_PEERCRED, &credentials, &length) == 0 &&
+                          credentials.uid == geteuid();
+        if (config.unixSeqPacket) {
+            conn->maxRecordSize = config.maxFrameSize + 4;  // 길이 헤더 포함
+        }
+    }
+    conn->busyPoll = listenSocket == shard.busyPollListenSocket || (conn->unixSocket && config.unixBusyPoll);
+    shard.backend->addConnection(*conn);
+    if (conn->busyPoll) {
+        updateBusyPoll(shard, 1);
+    }
+
+    startHeartbeat(shard, *conn);
+
+    shard.connections[clientSocket] = std::move(conn);
+    {
+        std::lock_guard<std::mutex> lock(routeMutex);
+        playerRoutes[playerId] = PlayerRoute{&shard, clientSocket};
+    }
+
+    // 플레이어 생성(client_connected)은 connect 메시지를 받을 때까지 미룸
+    // 연결이 몰릴 때 수락 경로에서 게임 계층을 거치지 않고, 핸드셰이크 없이 끊기는 연결은 비용이 없음
+}
@@ -8,7 +8,9 @@ PlayerInfo::PlayerInfo(EventBus& bus) :
     isReady(false),
     board(20, std::vector<int>(10, 0)),
     currentPos({0, 5}),
-    currentBlockType(0) {
+    currentBlockType(0),
+    pieceSeed(0),
+    piecesDrawn(0) {
     
     setupEventHandlers();
 }
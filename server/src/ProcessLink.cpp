@@ -0,0 +1,194 @@
+#include "ProcessLink.hpp"
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <string.h>
+
+// '@'로 시작하면 추상 네임스페이스 (sun_path 첫 바이트가 0이고 주소 길이로 이름의 끝을 정함)
+static socklen_t makeUnixAddress(const std::string& path, sockaddr_un& addr) {
+    addr = sockaddr_un{};
+    addr.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(addr.sun_path)) {
+        throw std::runtime_error("유닉스 소켓 경로가 잘못됨: " + path);
+    }
+
+    memcpy(addr.sun_path, path.data(), path.size());
+    socklen_t addrLength = offsetof(sockaddr_un, sun_path) + path.size();
+    if (path[0] == '@') {
+        addr.sun_path[0] = '\0';
+    } else {
+        addrLength += 1;
+    }
+    return addrLength;
+}
+
+ProcessLink::ProcessLink(int linkSocket, uint32_t maxRecordSize, size_t maxQueued) :
+    socket(linkSocket),
+    maxQueuedBytes(maxQueued),
+    open(true),
+    inbound(&bufferPool),
+    decoder(maxRecordSize) {
+}
+
+ProcessLink::~ProcessLink() {
+    close();
+    if (reader.joinable()) {
+        reader.join();
+    }
+    if (writer.joinable()) {
+        writer.join();
+    }
+    ::close(socket);
+}
+
+void ProcessLink::start(RecordHandler onRecord, CloseHandler onClose) {
+    reader = std::thread([this, onRecord, onClose]() {
+        readLoop(onRecord, onClose);
+    });
+    writer = std::thread([this]() {
+        writeLoop();
+    });
+}
+
+bool ProcessLink::send(const std::string& record) {
+    std::lock_guard<std::mutex> lock(outboxMutex);
+    if (!open) {
+        return false;
+    }
+    if (outbox.size() + record.size() + 4 > maxQueuedBytes) {
+        // 상대 프로세스가 멈췄거나 너무 느림: 메모리를 계속 쌓는 대신 링크를 끊음
+        std::cerr << "프로세스 링크 송신 큐 한도 초과 (" << outbox.size() << " 바이트), 링크 종료" << std::endl;
+        open = false;
+        shutdown(socket, SHUT_RDWR);
+        outboxReady.notify_one();
+        return false;
+    }
+
+    uint32_t size = record.size();
+    char header[4] = {
+        static_cast<char>((size >> 24) & 0xFF),
+        static_cast<char>((size >> 16) & 0xFF),
+        static_cast<char>((size >> 8) & 0xFF),
+        static_cast<char>(size & 0xFF)
+    };
+    bool wasEmpty = outbox.empty();
+    outbox.append(header, sizeof(header));
+    outbox.append(record);
+    if (wasEmpty) {
+        outboxReady.notify_one();
+    }
+    return true;
+}
+
+void ProcessLink::close() {
+    std::lock_guard<std::mutex> lock(outboxMutex);
+    if (open.exchange(false)) {
+        shutdown(socket, SHUT_RDWR);
+    }
+    outboxReady.notify_one();
+}
+
+void ProcessLink::readLoop(RecordHandler onRecord, CloseHandler onClose) {
+    while (true) {
+        inbound.reserve(READ_CHUNK);
+        iovec spans[2];
+        int count = inbound.writableSpans(spans);
+        ssize_t received = readv(socket, spans, count);
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            break;
+        }
+        inbound.commitWrite(received);
+
+        decoder.decode(inbound, [&onRecord](const char* data, size_t length) {
+            onRecord(data, length);
+            return true;
+        });
+        if (decoder.failed()) {
+            std::cerr << "프로세스 링크 레코드 크기 초과 (" << decoder.pendingFrameSize() << " 바이트), 링크 종료"
+                      << std::endl;
+            break;
+        }
+    }
+
+    close();
+    onClose();
+}
+
+void ProcessLink::writeLoop() {
+    std::unique_lock<std::mutex> lock(outboxMutex);
+    std::string pending;
+    while (true) {
+        outboxReady.wait(lock, [this]() { return !outbox.empty() || !open; });
+        if (!open) {
+            break;
+        }
+
+        // 쌓인 레코드를 통째로 가져와 락 밖에서 전송 (그동안 들어온 레코드는 다음 차례에 묶어 보냄)
+        pending.clear();
+        pending.swap(outbox);
+        lock.unlock();
+
+        size_t offset = 0;
+        while (offset < pending.size()) {
+            ssize_t sent = ::send(socket, pending.data() + offset, pending.size() - offset, MSG_NOSIGNAL);
+            if (sent < 0 && errno == EINTR) {
+                continue;
+            }
+            if (sent <= 0) {
+                break;
+            }
+            offset += sent;
+        }
+
+        lock.lock();
+        if (offset < pending.size()) {
+            std::cerr << "프로세스 링크 전송 실패: " << strerror(errno) << std::endl;
+            open = false;
+            shutdown(socket, SHUT_RDWR);
+            break;
+        }
+    }
+}
+
+int ProcessLink::connectUnix(const std::string& path) {
+    sockaddr_un addr;
+    socklen_t addrLength = makeUnixAddress(path, addr);
+
+    int linkSocket = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (linkSocket < 0) {
+        throw std::runtime_error("유닉스 소켓 생성 실패: " + std::string(strerror(errno)));
+    }
+    if (connect(linkSocket, (struct sockaddr*)&addr, addrLength) < 0) {
+        int error = errno;
+        ::close(linkSocket);
+        throw std::runtime_error("유닉스 소켓 연결 실패 (" + path + "): " + std::string(strerror(error)));
+    }
+    return linkSocket;
+}
+
+int ProcessLink::listenUnix(const std::string& path) {
+    sockaddr_un addr;
+    socklen_t addrLength = makeUnixAddress(path, addr);
+
+    int listenSocket = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenSocket < 0) {
+        throw std::runtime_error("유닉스 소켓 생성 실패: " + std::string(strerror(errno)));
+    }
+    if (path[0] != '@') {
+        // 이전 실행이 남긴 소켓 파일이 있으면 바인드가 실패하므로 먼저 제거
+        unlink(path.c_str());
+    }
+    if (::bind(listenSocket, (struct sockaddr*)&addr, addrLength) < 0 || listen(listenSocket, SOMAXCONN) < 0) {
+        int error = errno;
+        ::close(listenSocket);
+        throw std::runtime_error("유닉스 소켓 리슨 실패 (" + path + "): " + std::string(strerror(error)));
+    }
+    return listenSocket;
+}
@@ -0,0 +1,190 @@
+#include "RestartHandoff.hpp"
+#include "HotRestart.hpp"
+#include "ProcessLink.hpp"
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+RestartHandoff::RestartHandoff(const ServerConfig& serverConfig) :
+    config(serverConfig) {}
+
+void RestartHandoff::receive(int reactorCount) {
+    takeoverSocket = ProcessLink::connectUnix(config.takeoverPath);
+    std::cout << "이전 프로세스에서 소켓과 상태를 넘겨받는 중: " << config.takeoverPath << std::endl;
+    if (!HotRestart::receive(takeoverSocket, takeoverState, takeoverFds)) {
+        close(takeoverSocket);
+        takeoverSocket = -1;
+        throw std::runtime_error("이전 프로세스에서 상태를 넘겨받지 못함");
+    }
+
+    // 리스너 구성이 다르면 이어 받을 수 없음 (이 프로세스가 종료하면 이전 프로세스가 서비스를 재개)
+    const char* mismatch = nullptr;
+    if (takeoverState["reactors"].intValue != reactorCount) {
+        mismatch = "리액터 수";
+    } else if (takeoverState["port"].intValue != config.port ||
+               takeoverState["busy_poll_port"].intValue != config.busyPollPort) {
+        mismatch = "포트";
+    } else if (takeoverState["unix_path"].stringValue != config.unixPath) {
+        mismatch = "유닉스 소켓 경로";
+    }
+    if (mismatch) {
+        for (int fd : takeoverFds) {
+            close(fd);
+        }
+        takeoverFds.clear();
+        close(takeoverSocket);
+        takeoverSocket = -1;
+        throw std::runtime_error(std::string("이전 프로세스와 설정이 다름: ") + mismatch);
+    }
+}
+
+int RestartHandoff::inherited(const MessageData& index) const {
+    return index.intValue >= 0 ? takeoverFds.at(index.intValue) : -1;
+}
+
+void RestartHandoff::restoreConnection(const MessageData& saved, Connection& conn) const {
+    conn.handshaken = saved["handshaken"].boolValue;
+    conn.unixSocket = saved["unix"].boolValue;
+    conn.adminPeer = saved["admin"].boolValue;
+    if (conn.unixSocket && config.unixSeqPacket) {
+        conn.maxRecordSize = config.maxFrameSize + 4;
+    }
+    conn.busyPoll = saved["busy_poll"].boolValue;
+
+    const std::string& inbound = saved["inbound"].stringValue;
+    if (!inbound.empty()) {
+        conn.inbound.write(inbound.data(), inbound.size());
+    }
+    for (const MessageData& frame : saved["outbound"].arrayValue) {
+        conn.outbound.push_back(makeFrame(frame.stringValue));
+        conn.outboundBytes += frame.stringValue.size();
+    }
+}
+
+bool RestartHandoff::finishTakeover() {
+    // ACK가 늦어 이전 프로세스가 이미 서비스를 재개했으면 확정 ACK 없이 연결이 끊김
+    bool confirmed = HotRestart::sendAck(takeoverSocket) &&
+                     HotRestart::waitAck(takeoverSocket, HotRestart::ACK_TIMEOUT_MS);
+    close(takeoverSocket);
+    takeoverSocket = -1;
+    takeoverState = MessageData();
+    takeoverFds.clear();
+    if (!confirmed) {
+        abandoned = true;
+        std::cerr << "이전 프로세스가 넘겨주기를 확정하지 않음" << std::endl;
+    }
+    return confirmed;
+}
+
+void RestartHandoff::openListener(EventLoop& loop, std::function<void()> callback) {
+    listenLoop = &loop;
+    onSuccessor = std::move(callback);
+    listenSocket = ProcessLink::listenUnix(config.handoffPath);
+    loop.addFd(listenSocket, EPOLLIN, [this](uint32_t) {
+        acceptSuccessor();
+    });
+    std::cout << "무중단 재시작 대기: " << config.handoffPath << std::endl;
+}
+
+void RestartHandoff::closeListener() {
+    if (listenSocket < 0) {
+        return;
+    }
+    listenLoop->removeFd(listenSocket);
+    close(listenSocket);
+    listenSocket = -1;
+    if (config.handoffPath[0] != '@' && !completed) {
+        unlink(config.handoffPath.c_str());
+    }
+}
+
+void RestartHandoff::acceptSuccessor() {
+    int peer = accept4(listenSocket, nullptr, nullptr, SOCK_CLOEXEC);
+    if (peer < 0) {
+        return;
+    }
+
+    // 소켓과 게임 상태를 통째로 넘기므로 같은 사용자가 띄운 프로세스만 받음
+    ucred credentials{};
+    socklen_t length = sizeof(credentials);
+    if (getsockopt(peer, SOL_SOCKET, SO_PEERCRED, &credentials, &length) < 0 || credentials.uid != geteuid() ||
+        successor >= 0) {
+        std::cerr << "무중단 재시작 요청 거절 (uid " << credentials.uid << ")" << std::endl;
+        close(peer);
+        return;
+    }
+
+    std::cout << "후임 프로세스(pid " << credentials.pid << ") 접속, 리액터 정지" << std::endl;
+    successor = peer;
+    onSuccessor();
+}
+
+int RestartHandoff::pass(int fd) {
+    if (fd < 0) {
+        return -1;
+    }
+    passedFds.push_back(fd);
+    return static_cast<int>(passedFds.size() - 1);
+}
+
+MessageData RestartHandoff::saveConnection(const Connection& conn) {
+    MessageData connection;
+    connection["fd"] = pass(conn.socket);
+    connection["player_id"] = conn.playerId;
+    connection["handshaken"] = conn.handshaken;
+    connection["unix"] = conn.unixSocket;
+    connection["admin"] = conn.adminPeer;
+    connection["busy_poll"] = conn.busyPoll;
+
+    // 디코더가 헤더를 이미 소비한 부분 프레임이면 헤더를 앞에 되살려 후임이 처음부터 디코딩하게 함
+    std::string inbound;
+    if (uint32_t bodySize = conn.decoder.pendingBodySize()) {
+        char header[4] = {
+            static_cast<char>((bodySize >> 24) & 0xFF),
+            static_cast<char>((bodySize >> 16) & 0xFF),
+            static_cast<char>((bodySize >> 8) & 0xFF),
+            static_cast<char>(bodySize & 0xFF)
+        };
+        inbound.append(header, sizeof(header));
+    }
+    size_t buffered = inbound.size();
+    inbound.resize(buffered + conn.inbound.size());
+    conn.inbound.peek(0, &inbound[buffered], conn.inbound.size());
+    connection["inbound"] = inbound;
+
+    // 송신 큐는 프레임 단위로 넘김 (SEQPACKET은 레코드 하나가 프레임 하나여야 함)
+    MessageData outbound;
+    outbound.type = MessageData::Array;
+    size_t offset = conn.outboundOffset;
+    for (const FramePtr& frame : conn.outbound) {
+        outbound.push_back(MessageData(frame->substr(offset)));
+        offset = 0;
+    }
+    connection["outbound"] = outbound;
+    return connection;
+}
+
+bool RestartHandoff::handOff(const MessageData& state) {
+    int peer = successor;
+    successor = -1;
+    std::vector<int> fds;
+    fds.swap(passedFds);
+
+    // 확정 ACK를 보낸 뒤로는 후임이 서비스하므로 되돌리지 않음 (보내지 못했으면 후임은 확정을 못 받고 종료)
+    bool acknowledged = HotRestart::send(peer, state, fds) && HotRestart::waitAck(peer, HotRestart::ACK_TIMEOUT_MS) &&
+                        HotRestart::sendAck(peer);
+    close(peer);
+    if (!acknowledged) {
+        std::cerr << "후임 프로세스에 넘기지 못함, 서비스 재개" << std::endl;
+        return false;
+    }
+
+    // 이 프로세스의 소켓 fd는 종료하면서 닫힐 뿐 연결은 후임 프로세스에서 계속됨
+    completed = true;
+    std::cout << "후임 프로세스에 연결 " << state["connections"].size() << "개 넘김, 종료" << std::endl;
+    return true;
+}
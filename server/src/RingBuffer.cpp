@@ -0,0 +1,121 @@
+#include "RingBuffer.hpp"
+#include <cstring>
+#include <algorithm>
+
+RingBuffer::RingBuffer(BufferPool* bufferPool) :
+    pool(bufferPool),
+    buffer(nullptr),
+    bufferSize(0),
+    mask(0),
+    readPos(0),
+    writePos(0) {
+}
+
+RingBuffer::~RingBuffer() {
+    deallocate();
+}
+
+char* RingBuffer::allocate(size_t size) {
+    if (pool) {
+        return pool->acquire(size);
+    }
+    return new char[BufferPool::classSize(size)];
+}
+
+void RingBuffer::deallocate() {
+    if (pool) {
+        pool->release(buffer, bufferSize);
+    } else {
+        delete[] buffer;
+    }
+    buffer = nullptr;
+    bufferSize = 0;
+    mask = 0;
+}
+
+void RingBuffer::clear() {
+    if (buffer) {
+        deallocate();
+    }
+    readPos = 0;
+    writePos = 0;
+}
+
+void RingBuffer::reserve(size_t minFree) {
+    if (freeSpace() >= minFree) {
+        return;
+    }
+
+    // 남은 데이터를 새 버퍼 앞쪽으로 옮기며 확장
+    size_t used = size();
+    size_t grownSize = BufferPool::classSize(used + minFree);
+    char* grown = allocate(grownSize);
+    if (used > 0) {
+        peek(0, grown, used);
+    }
+
+    deallocate();
+    buffer = grown;
+    bufferSize = grownSize;
+    mask = bufferSize - 1;
+    readPos = 0;
+    writePos = used;
+}
+
+int RingBuffer::writableSpans(iovec spans[2]) {
+    size_t available = freeSpace();
+    if (available == 0) {
+        return 0;
+    }
+
+    size_t start = writePos & mask;
+    size_t firstLength = std::min(available, capacity() - start);
+
+    spans[0].iov_base = buffer + start;
+    spans[0].iov_len = firstLength;
+    if (firstLength == available) {
+        return 1;
+    }
+
+    spans[1].iov_base = buffer;
+    spans[1].iov_len = available - firstLength;
+    return 2;
+}
+
+void RingBuffer::commitWrite(size_t length) {
+    writePos += length;
+}
+
+void RingBuffer::write(const char* data, size_t length) {
+    reserve(length);
+
+    size_t start = writePos & mask;
+    size_t firstLength = std::min(length, capacity() - start);
+    memcpy(buffer + start, data, firstLength);
+    memcpy(buffer, data + firstLength, length - firstLength);
+    writePos += length;
+}
+
+const char* RingBuffer::contiguous(size_t offset, size_t length) const {
+    size_t start = (readPos + offset) & mask;
+    if (start + length > capacity()) {
+        return nullptr;
+    }
+    return buffer + start;
+}
+
+void RingBuffer::peek(size_t offset, char* dst, size_t length) const {
+    size_t start = (readPos + offset) & mask;
+    size_t firstLength = std::min(length, capacity() - start);
+    memcpy(dst, buffer + start, firstLength);
+    memcpy(dst + firstLength, buffer, length - firstLength);
+}
+
+void RingBuffer::consume(size_t length) {
+    readPos += length;
+    // 비었으면 버퍼를 풀에 돌려줌 (다음 수신에서 기본 크기로 다시 빌림)
+    if (readPos == writePos) {
+        readPos = writePos = 0;
+        deallocate();
+    }
+}
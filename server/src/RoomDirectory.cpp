@@ -0,0 +1,69 @@
+#include "RoomDirectory.hpp"
+#include <cstdlib>
+#include <stdexcept>
+
+RoomDirectory::RoomDirectory(const std::vector<std::string>& nodeList, int self) :
+    selfIndex(self) {
+    for (const std::string& address : nodeList) {
+        size_t colon = address.rfind(':');
+        int port = colon == std::string::npos ? 0 : std::atoi(address.c_str() + colon + 1);
+        if (colon == 0 || port <= 0 || port > 65535) {
+            throw std::runtime_error("노드 주소 형식 오류 (호스트:포트): " + address);
+        }
+        nodes.push_back(Node{address.substr(0, colon), port});
+        nodeKeys.push_back(address);
+    }
+    if (!nodes.empty() && (selfIndex < 0 || selfIndex >= static_cast<int>(nodes.size()))) {
+        throw std::runtime_error("노드 목록에서 이 노드의 번호가 범위를 벗어남: " + std::to_string(selfIndex));
+    }
+}
+
+int RoomDirectory::ownerOf(const std::string& room) const {
+    {
+        std::lock_guard<std::mutex> lock(overrideMutex);
+        auto it = overrides.find(room);
+        if (it != overrides.end()) {
+            return it->second;
+        }
+    }
+
+    int owner = 0;
+    uint64_t best = 0;
+    for (size_t i = 0; i < nodeKeys.size(); ++i) {
+        uint64_t value = score(room, nodeKeys[i]);
+        if (i == 0 || value > best) {
+            best = value;
+            owner = static_cast<int>(i);
+        }
+    }
+    return owner;
+}
+
+bool RoomDirectory::assign(const std::string& room, int owner) {
+    if (owner < 0 || owner >= size()) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(overrideMutex);
+    overrides[room] = owner;
+    return true;
+}
+
+uint64_t RoomDirectory::score(const std::string& room, const std::string& nodeKey) {
+    // FNV-1a로 (방, 노드)를 해싱한 뒤 splitmix64 마무리로 비트를 고르게 섞음
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](const std::string& text) {
+        for (unsigned char c : text) {
+            hash ^= c;
+            hash *= 1099511628211ULL;
+        }
+    };
+    mix(room);
+    hash ^= 0xFF;  // 방 이름과 노드 주소의 경계 (다른 쌍이 같은 바이트열이 되지 않게)
+    hash *= 1099511628211ULL;
+    mix(nodeKey);
+
+    hash += 0x9E3779B97F4A7C15ULL;
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+    return hash ^ (hash >> 31);
+}
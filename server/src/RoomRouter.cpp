@@ -0,0 +1,195 @@
+#include "RoomRouter.hpp"
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+RoomRouter::RoomRouter(const ServerConfig& serverConfig, EventBus& bus, SessionRegistry& registry, Sender sender) :
+    config(serverConfig),
+    eventBus(bus),
+    sessions(registry),
+    send(std::move(sender)),
+    directory(serverConfig.nodes, serverConfig.nodeIndex) {}
+
+void RoomRouter::redirect(int playerId, const std::string& room) {
+    int owner = directory.ownerOf(room);
+    const RoomDirectory::Node& node = directory.node(owner);
+
+    MessageData message;
+    message["type"] = "redirect";
+    message["room"] = room;
+    message["host"] = node.host;
+    message["port"] = node.port;
+    std::cout << "플레이어 " << playerId << " 재연결 안내: 방 '" << room << "' 소속 노드 " << owner << " ("
+              << node.host << ":" << node.port << ")" << std::endl;
+    send(playerId, message);
+
+    // 클라이언트가 이 연결을 끊으면 바로 정리되도록 재연결 세션은 폐기 (상태를 보관할 이유가 없음)
+    sessions.revoke(playerId);
+}
+
+void RoomRouter::handleCommand(int requesterId, bool trusted, const std::string& command, const MessageData& msg,
+                               const std::function<int()>& allocatePlayerId) {
+    MessageData reply;
+    reply["type"] = "error";
+    reply["command"] = command;
+
+    // 관리 명령은 서버와 같은 uid로 확인된 AF_UNIX 연결에서만 받음 (같은 리스너의 로컬 봇은 거절)
+    if (!trusted) {
+        reply["reason"] = "forbidden";
+        send(requesterId, reply);
+        return;
+    }
+    // 게임 상태가 시뮬레이션 프로세스에 있으면 이 프로세스에서 스냅샷을 뜰 수 없음
+    if (config.role != ServerConfig::Role::Standalone) {
+        reply["reason"] = "unsupported";
+        send(requesterId, reply);
+        return;
+    }
+    std::string room = msg.contains("room") ? msg["room"].stringValue : "";
+    if (room.empty()) {
+        reply["reason"] = "missing room";
+        send(requesterId, reply);
+        return;
+    }
+
+    if (command == "room_export") {
+        // GameManager가 room_snapshot으로 응답하면 이 연결로 전달
+        std::cout << "방 '" << room << "' 이동 시작: 스냅샷 요청" << std::endl;
+        eventBus.publish("room_export", {{"room", room}, {"reply_to", requesterId}});
+        return;
+    }
+    if (command == "room_import") {
+        importRoom(requesterId, msg, allocatePlayerId);
+        return;
+    }
+    if (command == "room_commit") {
+        commitMove(requesterId, msg);
+        return;
+    }
+    if (command == "room_resume") {
+        std::cout << "방 '" << room << "' 이동 취소, 다시 진행" << std::endl;
+        eventBus.publish("room_resume", {{"room", room}});
+        reply["type"] = "room_resumed";
+        reply["room"] = room;
+        send(requesterId, reply);
+        return;
+    }
+    if (command == "room_assign") {
+        int node = msg.contains("node") ? static_cast<int>(msg["node"].intValue) : -1;
+        if (!directory.assign(room, node)) {
+            reply["reason"] = "bad node";
+            send(requesterId, reply);
+            return;
+        }
+        reply["type"] = "room_assigned";
+        reply["room"] = room;
+        reply["node"] = node;
+        send(requesterId, reply);
+        return;
+    }
+
+    reply["reason"] = "unknown command";
+    send(requesterId, reply);
+}
+
+void RoomRouter::importRoom(int requesterId, const MessageData& msg, const std::function<int()>& allocatePlayerId) {
+    MessageData reply;
+    reply["type"] = "error";
+    reply["command"] = "room_import";
+
+    // 클라이언트가 새 노드에 다시 붙을 때까지 상태를 보관하려면 재연결 세션이 필요함
+    if (!sessions.enabled() || !msg.contains("snapshot")) {
+        reply["reason"] = !sessions.enabled() ? "sessions disabled" : "missing snapshot";
+        send(requesterId, reply);
+        return;
+    }
+
+    MessageData snapshot;
+    try {
+        snapshot = MessageData::deserialize(msg["snapshot"].stringValue);
+    } catch (const std::exception& e) {
+        std::cerr << "방 스냅샷 해석 실패: " << e.what() << std::endl;
+    }
+    std::string room = msg["room"].stringValue;
+    if (snapshot["room"].stringValue != room) {
+        reply["reason"] = "bad snapshot";
+        send(requesterId, reply);
+        return;
+    }
+
+    // 플레이어 ID는 노드마다 따로 할당하므로 새 ID로 복원하고 원래 ID → 재연결 토큰을 돌려줌
+    MessageData restored;
+    restored.type = MessageData::Object;
+    MessageData tokens;
+    tokens.type = MessageData::Object;
+    std::vector<int> playerIds;
+    for (const auto& [oldId, state] : snapshot["players"].objectValue) {
+        int playerId = allocatePlayerId();
+        restored[std::to_string(playerId)] = state;
+        tokens[oldId] = sessions.issue(playerId);
+        playerIds.push_back(playerId);
+    }
+    eventBus.publish("room_restore", {{"room", room}, {"players", restored}});
+
+    // 복원한 플레이어는 연결이 없으므로 끊긴 세션처럼 유예 시간 안에 resume하지 않으면 정리
+    for (int playerId : playerIds) {
+        sessions.suspend(playerId);
+    }
+    if (directory.enabled()) {
+        directory.assign(room, directory.self());
+    }
+
+    std::cout << "방 '" << room << "' 가져옴: 플레이어 " << tokens.size() << "명" << std::endl;
+    reply["type"] = "room_imported";
+    reply["room"] = room;
+    reply["players"] = static_cast<int64_t>(tokens.size());
+    reply["tokens"] = tokens.serialize();
+    send(requesterId, reply);
+}
+
+void RoomRouter::commitMove(int requesterId, const MessageData& msg) {
+    MessageData reply;
+    reply["type"] = "error";
+    reply["command"] = "room_commit";
+
+    std::string room = msg["room"].stringValue;
+    int node = msg.contains("node") ? static_cast<int>(msg["node"].intValue) : -1;
+    MessageData tokens;
+    try {
+        tokens = MessageData::deserialize(msg.contains("tokens") ? msg["tokens"].stringValue : std::string());
+    } catch (const std::exception& e) {
+        std::cerr << "방 이동 토큰 해석 실패: " << e.what() << std::endl;
+    }
+    bool validTokens = tokens.type == MessageData::Object;
+    if (!validTokens || node == directory.self() || !directory.assign(room, node)) {
+        reply["reason"] = validTokens ? "bad node" : "bad tokens";
+        send(requesterId, reply);
+        return;
+    }
+
+    // 이후 이 방으로 접속하는 클라이언트도 새 노드로 안내됨
+    const RoomDirectory::Node& target = directory.node(node);
+    for (const auto& [id, token] : tokens.objectValue) {
+        int playerId = std::stoi(id);
+        MessageData message;
+        message["type"] = "redirect";
+        message["room"] = room;
+        message["host"] = target.host;
+        message["port"] = target.port;
+        message["session_token"] = token.intValue;
+        send(playerId, message);
+
+        // 클라이언트가 이 연결을 끊으면 바로 정리 (상태는 이미 새 노드에 있음)
+        sessions.revoke(playerId);
+    }
+
+    std::cout << "방 '" << room << "' 노드 " << node << " (" << target.host << ":" << target.port << ")로 이동, 플레이어 "
+              << tokens.size() << "명 재연결 안내" << std::endl;
+    reply["type"] = "room_committed";
+    reply["room"] = room;
+    reply["node"] = node;
+    reply["players"] = static_cast<int64_t>(tokens.size());
+    send(requesterId, reply);
+}
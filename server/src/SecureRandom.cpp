@@ -0,0 +1,22 @@
+#include "SecureRandom.hpp"
+#include <sys/random.h>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+int64_t SecureRandom::token() {
+    uint64_t value;
+    do {
+        // 256바이트 이하 요청은 시그널로 중간에 끊기지 않지만 EINTR은 다시 시도
+        ssize_t filled;
+        do {
+            filled = getrandom(&value, sizeof(value), 0);
+        } while (filled < 0 && errno == EINTR);
+        if (filled != static_cast<ssize_t>(sizeof(value))) {
+            throw std::runtime_error(std::string("getrandom 실패: ") + strerror(errno));
+        }
+        value >>= 1;
+    } while (value == 0);
+    return static_cast<int64_t>(value);
+}
@@ -0,0 +1,158 @@
+#include "SessionRegistry.hpp"
+#include "SecureRandom.hpp"
+#include <time.h>
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+static int64_t monotonicMs() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000LL + now.tv_nsec / 1000000;
+}
+
+SessionRegistry::SessionRegistry(int grace, EventLoop& loop, TimerWheel& timerWheel, EventBus& bus) :
+    graceMs(grace),
+    eventLoop(loop),
+    timers(timerWheel),
+    eventBus(bus) {
+    expiryTimer.onExpire = [this]() {
+        expire();
+    };
+}
+
+SessionRegistry::~SessionRegistry() {
+    timers.cancel(expiryTimer);
+}
+
+int64_t SessionRegistry::issue(int playerId) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto existing = playerTokens.find(playerId);
+    if (existing != playerTokens.end()) {
+        return existing->second;
+    }
+
+    // 토큰만 알면 다른 플레이어를 가로챌 수 있으므로 추측할 수 없는 값으로, 이미 쓰는 토큰과 겹치면 다시 뽑음
+    int64_t token;
+    do {
+        token = SecureRandom::token();
+    } while (sessions.count(token));
+
+    sessions[token] = Session{playerId, false, 0};
+    playerTokens[playerId] = token;
+    return token;
+}
+
+int SessionRegistry::claim(int64_t token, int requesterId) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = sessions.find(token);
+    if (it == sessions.end() || it->second.playerId == requesterId) {
+        return -1;
+    }
+    it->second.suspended = false;
+    return it->second.playerId;
+}
+
+bool SessionRegistry::suspend(int playerId) {
+    if (graceMs <= 0) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto token = playerTokens.find(playerId);
+        if (token == playerTokens.end()) {
+            return false;
+        }
+        Session& session = sessions[token->second];
+        session.suspended = true;
+        session.expiresAtMs = monotonicMs() + graceMs;
+    }
+    scheduleExpiry();
+    return true;
+}
+
+void SessionRegistry::revoke(int playerId) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto token = playerTokens.find(playerId);
+    if (token != playerTokens.end()) {
+        sessions.erase(token->second);
+        playerTokens.erase(token);
+    }
+}
+
+bool SessionRegistry::contains(int playerId) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return playerTokens.count(playerId) > 0;
+}
+
+MessageData SessionRegistry::save() const {
+    MessageData saved;
+    saved.type = MessageData::Object;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    int64_t now = monotonicMs();
+    for (const auto& [token, session] : sessions) {
+        MessageData entry;
+        entry["player_id"] = session.playerId;
+        entry["suspended"] = session.suspended;
+        entry["remaining_ms"] = session.suspended ? std::max<int64_t>(0, session.expiresAtMs - now) : int64_t(0);
+        saved[std::to_string(token)] = entry;
+    }
+    return saved;
+}
+
+void SessionRegistry::restore(const MessageData& saved) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        int64_t now = monotonicMs();
+        for (const auto& [token, entry] : saved.objectValue) {
+            int playerId = static_cast<int>(entry["player_id"].intValue);
+            bool suspended = entry["suspended"].boolValue;
+            sessions[std::stoll(token)] = Session{playerId, suspended, now + entry["remaining_ms"].intValue};
+            playerTokens[playerId] = std::stoll(token);
+        }
+    }
+    scheduleExpiry();
+}
+
+void SessionRegistry::scheduleExpiry() {
+    // 타이머 휠은 소유 리액터 스레드에서만 다룰 수 있으므로 그 스레드에서 다시 계산
+    eventLoop.post([this]() {
+        expire();
+    });
+}
+
+void SessionRegistry::expire() {
+    std::vector<int> expired;
+    int64_t now = monotonicMs();
+    int64_t nextExpiry = INT64_MAX;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto it = sessions.begin(); it != sessions.end();) {
+            const Session& session = it->second;
+            if (session.suspended && session.expiresAtMs <= now) {
+                expired.push_back(session.playerId);
+                playerTokens.erase(session.playerId);
+                it = sessions.erase(it);
+                continue;
+            }
+            if (session.suspended) {
+                nextExpiry = std::min(nextExpiry, session.expiresAtMs);
+            }
+            ++it;
+        }
+    }
+
+    for (int playerId : expired) {
+        std::cout << "플레이어 " << playerId << " 재연결 유예 시간 만료, 제거" << std::endl;
+        eventBus.publish("client_disconnected", {{"player_id", playerId}});
+    }
+
+    if (nextExpiry == INT64_MAX) {
+        timers.cancel(expiryTimer);
+    } else {
+        timers.schedule(expiryTimer, timers.toTicks(static_cast<int>(nextExpiry - now)));
+    }
+}
@@ -0,0 +1,116 @@
+#include "SharedMemoryChannel.hpp"
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+#include <stdexcept>
+
+SharedMemoryChannel::SharedMemoryChannel(size_t ringSize, uint32_t maxFrameSize) :
+    memFd(-1),
+    serverEventFd(-1),
+    clientEventFd(-1),
+    mapping(nullptr),
+    frameDecoder(maxFrameSize) {
+    // 링 용량보다 큰 프레임은 영원히 완성되지 않으므로 최대 프레임이 들어가도록 키움
+    ringBytes = DATA_OFFSET;
+    while (ringBytes < ringSize || ringBytes < static_cast<size_t>(maxFrameSize) + 4) {
+        ringBytes <<= 1;
+    }
+    mappingSize = DATA_OFFSET + ringBytes * 2;
+
+    memFd = memfd_create("tetris-shm", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (memFd < 0) {
+        throw std::runtime_error("memfd 생성 실패: " + std::string(strerror(errno)));
+    }
+
+    // 봇이 크기를 줄여 서버 쪽 매핑에서 SIGBUS가 나지 않도록 크기를 봉인
+    if (ftruncate(memFd, mappingSize) < 0 ||
+        fcntl(memFd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) < 0) {
+        int error = errno;
+        close(memFd);
+        throw std::runtime_error("공유 메모리 크기 설정 실패: " + std::string(strerror(error)));
+    }
+
+    void* address = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, memFd, 0);
+    if (address == MAP_FAILED) {
+        int error = errno;
+        close(memFd);
+        throw std::runtime_error("공유 메모리 매핑 실패: " + std::string(strerror(error)));
+    }
+    mapping = static_cast<char*>(address);
+
+    serverEventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    clientEventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (serverEventFd < 0 || clientEventFd < 0) {
+        int error = errno;
+        release();
+        throw std::runtime_error("도어벨 eventfd 생성 실패: " + std::string(strerror(error)));
+    }
+
+    // 새 memfd는 0으로 채워져 있으므로 헤더는 모두 0에서 시작
+    auto* headers = reinterpret_cast<SharedRingHeader*>(mapping);
+    toServer.attach(&headers[0], mapping + DATA_OFFSET, ringBytes);
+    toClient.attach(&headers[1], mapping + DATA_OFFSET + ringBytes, ringBytes);
+}
+
+SharedMemoryChannel::~SharedMemoryChannel() {
+    release();
+}
+
+void SharedMemoryChannel::release() {
+    if (mapping) {
+        munmap(mapping, mappingSize);
+        mapping = nullptr;
+    }
+    if (memFd >= 0) {
+        close(memFd);
+        memFd = -1;
+    }
+    if (serverEventFd >= 0) {
+        close(serverEventFd);
+        serverEventFd = -1;
+    }
+    if (clientEventFd >= 0) {
+        close(clientEventFd);
+        clientEventFd = -1;
+    }
+}
+
+void SharedMemoryChannel::drainDoorbell() {
+    uint64_t count;
+    while (read(serverEventFd, &count, sizeof(count)) > 0) {
+    }
+}
+
+void SharedMemoryChannel::notifyClient() {
+    uint64_t one = 1;
+    ssize_t written = write(clientEventFd, &one, sizeof(one));
+    (void)written;
+}
+
+bool SharedMemoryChannel::sendHandshake(int socket, const std::string& frame) const {
+    int fds[3] = {memFd, serverEventFd, clientEventFd};
+
+    iovec span;
+    span.iov_base = const_cast<char*>(frame.data());
+    span.iov_len = frame.size();
+
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(fds))] = {};
+    msghdr message{};
+    message.msg_iov = &span;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    cmsghdr* header = CMSG_FIRSTHDR(&message);
+    header->cmsg_level = SOL_SOCKET;
+    header->cmsg_type = SCM_RIGHTS;
+    header->cmsg_len = CMSG_LEN(sizeof(fds));
+    memcpy(CMSG_DATA(header), fds, sizeof(fds));
+
+    ssize_t sent = sendmsg(socket, &message, MSG_DONTWAIT | MSG_NOSIGNAL);
+    return sent == static_cast<ssize_t>(frame.size());
+}
@@ -0,0 +1,111 @@
+#include "SharedRing.hpp"
+#include <string.h>
+#include <algorithm>
+
+SharedRing::SharedRing() :
+    header(nullptr),
+    data(nullptr),
+    ringCapacity(0),
+    mask(0),
+    readPos(0),
+    writePos(0),
+    corrupted(false) {
+}
+
+void SharedRing::attach(SharedRingHeader* ringHeader, char* ringData, size_t capacity) {
+    header = ringHeader;
+    data = ringData;
+    ringCapacity = capacity;
+    mask = capacity - 1;
+    readPos = header->head.load(std::memory_order_acquire);
+    writePos = header->tail.load(std::memory_order_acquire);
+}
+
+size_t SharedRing::size() {
+    uint64_t available = header->tail.load(std::memory_order_acquire) - readPos;
+    if (available > ringCapacity) {
+        corrupted = true;
+        return 0;
+    }
+    return available;
+}
+
+const char* SharedRing::contiguous(size_t offset, size_t length) const {
+    size_t start = (readPos + offset) & mask;
+    if (start + length <= ringCapacity) {
+        return data + start;
+    }
+    return nullptr;
+}
+
+void SharedRing::peek(size_t offset, char* dst, size_t length) const {
+    size_t start = (readPos + offset) & mask;
+    size_t first = std::min(length, ringCapacity - start);
+    memcpy(dst, data + start, first);
+    memcpy(dst + first, data, length - first);
+}
+
+void SharedRing::consume(size_t length) {
+    readPos += length;
+    header->head.store(readPos, std::memory_order_release);
+}
+
+size_t SharedRing::write(const iovec* spans, int count) {
+    uint64_t used = writePos - header->head.load(std::memory_order_acquire);
+    if (used > ringCapacity) {
+        corrupted = true;
+        return 0;
+    }
+
+    size_t freeSpace = ringCapacity - used;
+    size_t written = 0;
+    for (int i = 0; i < count && written < freeSpace; ++i) {
+        const char* source = static_cast<const char*>(spans[i].iov_base);
+        size_t length = std::min(spans[i].iov_len, freeSpace - written);
+
+        size_t start = (writePos + written) & mask;
+        size_t first = std::min(length, ringCapacity - start);
+        memcpy(data + start, source, first);
+        memcpy(data, source + first, length - first);
+        written += length;
+    }
+
+    if (written > 0) {
+        writePos += written;
+        header->tail.store(writePos, std::memory_order_release);
+    }
+    return written;
+}
+
+bool SharedRing::prepareConsumerWait() {
+    // 플래그를 세운 뒤 다시 확인해야 상대가 그사이 쓴 데이터를 놓치지 않음 (플래그와 위치 모두 seq_cst 순서)
+    header->consumerWaiting.store(1, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (size() > 0 || corrupted) {
+        header->consumerWaiting.store(0, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+bool SharedRing::prepareProducerWait() {
+    header->producerWaiting.store(1, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (writePos - header->head.load(std::memory_order_acquire) < ringCapacity) {
+        header->producerWaiting.store(0, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+bool SharedRing::takeConsumerWaiting() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return header->consumerWaiting.load(std::memory_order_relaxed) != 0 &&
+           header->consumerWaiting.exchange(0) != 0;
+}
+
+bool SharedRing::takeProducerWaiting() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return header->producerWaiting.load(std::memory_order_relaxed) != 0 &&
+           header->producerWaiting.exchange(0) != 0;
+}
@@ -1,10 +1,16 @@
 #include "SimpleMessagePack.hpp"
 #include <sstream>
 #include <iomanip>
+#include <cstring>
+#include <stdexcept>
 
 std::string MessageData::serialize() const {
     std::string result;
-    
+    serializeTo(result);
+    return result;
+}
+
+void MessageData::serializeTo(std::string& result) const {
     // 타입 정보 추가 (1바이트)
     result.push_back(static_cast<char>(type));
     
@@ -52,8 +58,7 @@ std::string MessageData::serialize() const {
                 result.push_back((size >> (i * 8)) & 0xFF);
             }
             for (const auto& item : arrayValue) {
-                std::string itemData = item.serialize();
-                result.append(itemData);
+                item.serializeTo(result);
             }
             break;
         }
@@ -72,14 +77,11 @@ std::string MessageData::serialize() const {
                 }
                 result.append(key);
                 
-                std::string valueData = value.serialize();
-                result.append(valueData);
+                value.serializeTo(result);
             }
             break;
         }
     }
-    
-    return result;
 }
 
 MessageData MessageData::deserialize(const std::string& data) {
@@ -175,4 +177,152 @@ MessageData MessageData::deserializeValue(const std::string& data, size_t& pos)
     }
     
     return result;
-} 
\ No newline at end of file
+} 
+// 표준 MessagePack 읽기 (https://github.com/msgpack/msgpack/blob/master/spec.md)
+namespace {
+
+class MsgPackReader {
+public:
+    MsgPackReader(const char* bytes, size_t size) :
+        data(reinterpret_cast<const uint8_t*>(bytes)), length(size), pos(0) {}
+
+    MessageData readValue(int depth) {
+        // 악의적으로 깊게 중첩된 입력에서 스택이 넘치지 않도록 제한
+        if (depth > MAX_DEPTH) {
+            throw std::runtime_error("MessagePack 중첩이 너무 깊음");
+        }
+
+        uint8_t tag = readByte();
+        if (tag <= 0x7f) {
+            return MessageData(static_cast<int64_t>(tag));
+        }
+        if (tag >= 0xe0) {
+            return MessageData(static_cast<int64_t>(static_cast<int8_t>(tag)));
+        }
+        if ((tag & 0xf0) == 0x80) {
+            return readMap(tag & 0x0f, depth);
+        }
+        if ((tag & 0xf0) == 0x90) {
+            return readArray(tag & 0x0f, depth);
+        }
+        if ((tag & 0xe0) == 0xa0) {
+            return MessageData(readString(tag & 0x1f));
+        }
+
+        switch (tag) {
+            case 0xc0: return MessageData();
+            case 0xc2: return MessageData(false);
+            case 0xc3: return MessageData(true);
+            case 0xca: {
+                uint32_t bits = static_cast<uint32_t>(readUnsigned(4));
+                float value;
+                memcpy(&value, &bits, sizeof(value));
+                return MessageData(static_cast<double>(value));
+            }
+            case 0xcb: {
+                uint64_t bits = readUnsigned(8);
+                double value;
+                memcpy(&value, &bits, sizeof(value));
+                return MessageData(value);
+            }
+            case 0xcc: return MessageData(static_cast<int64_t>(readUnsigned(1)));
+            case 0xcd: return MessageData(static_cast<int64_t>(readUnsigned(2)));
+            case 0xce: return MessageData(static_cast<int64_t>(readUnsigned(4)));
+            case 0xcf: return MessageData(static_cast<int64_t>(readUnsigned(8)));
+            case 0xd0: return MessageData(static_cast<int64_t>(static_cast<int8_t>(readUnsigned(1))));
+            case 0xd1: return MessageData(static_cast<int64_t>(static_cast<int16_t>(readUnsigned(2))));
+            case 0xd2: return MessageData(static_cast<int64_t>(static_cast<int32_t>(readUnsigned(4))));
+            case 0xd3: return MessageData(static_cast<int64_t>(readUnsigned(8)));
+            // bin은 문자열에 바이트 그대로 담음 (방 이동 스냅샷처럼 MessageData 직렬화를 실어 보낼 때)
+            case 0xc4: return MessageData(readString(readUnsigned(1)));
+            case 0xc5: return MessageData(readString(readUnsigned(2)));
+            case 0xc6: return MessageData(readString(readUnsigned(4)));
+            case 0xd9: return MessageData(readString(readUnsigned(1)));
+            case 0xda: return MessageData(readString(readUnsigned(2)));
+            case 0xdb: return MessageData(readString(readUnsigned(4)));
+            case 0xdc: return readArray(readUnsigned(2), depth);
+            case 0xdd: return readArray(readUnsigned(4), depth);
+            case 0xde: return readMap(readUnsigned(2), depth);
+            case 0xdf: return readMap(readUnsigned(4), depth);
+        }
+        throw std::runtime_error("지원하지 않는 MessagePack 형식: 0x" + toHex(tag));
+    }
+
+    bool finished() const { return pos == length; }
+
+private:
+    static const int MAX_DEPTH = 32;
+
+    const uint8_t* data;
+    size_t length;
+    size_t pos;
+
+    void require(size_t count) const {
+        if (length - pos < count) {
+            throw std::runtime_error("MessagePack 데이터가 잘림");
+        }
+    }
+
+    uint8_t readByte() {
+        require(1);
+        return data[pos++];
+    }
+
+    // 빅엔디언 부호 없는 정수
+    uint64_t readUnsigned(int bytes) {
+        require(bytes);
+        uint64_t value = 0;
+        for (int i = 0; i < bytes; i++) {
+            value = (value << 8) | data[pos++];
+        }
+        return value;
+    }
+
+    std::string readString(uint64_t size) {
+        require(size);
+        std::string value(reinterpret_cast<const char*>(data + pos), size);
+        pos += size;
+        return value;
+    }
+
+    MessageData readArray(uint64_t count, int depth) {
+        // 원소마다 최소 1바이트이므로 남은 길이보다 큰 개수는 잘린 데이터 (미리 할당하지 않음)
+        require(count);
+        MessageData result = MessageData::array();
+        for (uint64_t i = 0; i < count; i++) {
+            result.push_back(readValue(depth + 1));
+        }
+        return result;
+    }
+
+    MessageData readMap(uint64_t count, int depth) {
+        require(count * 2);
+        MessageData result;
+        result.type = MessageData::Object;
+        for (uint64_t i = 0; i < count; i++) {
+            MessageData key = readValue(depth + 1);
+            if (key.type != MessageData::String) {
+                throw std::runtime_error("MessagePack 맵 키가 문자열이 아님");
+            }
+            result.objectValue[key.stringValue] = readValue(depth + 1);
+        }
+        return result;
+    }
+
+    static std::string toHex(uint8_t value) {
+        std::ostringstream out;
+        out << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(value);
+        return out.str();
+    }
+};
+
+}  // namespace
+
+MessageData SimpleMessagePack::unpackMsgPack(const char* data, size_t length) {
+    MsgPackReader reader(data, length);
+    MessageData result = reader.readValue(0);
+    if (!reader.finished()) {
+        throw std::runtime_error("MessagePack 값 뒤에 남은 데이터가 있음");
+    }
+    return result;
+}
@@ -0,0 +1,171 @@
+#include "SimulationHost.hpp"
+#include "SimulationProtocol.hpp"
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <iostream>
+#include <string.h>
+
+SimulationHost::SimulationHost(const ServerConfig& config, EventBus& bus) :
+    eventBus(bus),
+    path(config.simulationPaths.at(0)),
+    listenSocket(ProcessLink::listenUnix(path)),
+    running(true),
+    nextGatewayId(1) {
+    std::cout << "시뮬레이션 프로세스 리슨: " << path << std::endl;
+    setupEventHandlers();
+}
+
+SimulationHost::~SimulationHost() {
+    stop();
+
+    // 링크를 락 밖에서 해제 (수신 스레드가 이벤트 처리 중 gatewayMutex를 기다리고 있을 수 있음)
+    std::unordered_map<int, std::unique_ptr<ProcessLink>> links;
+    {
+        std::lock_guard<std::mutex> lock(gatewayMutex);
+        links.swap(gateways);
+    }
+    for (auto& [id, link] : links) {
+        link->close();
+    }
+    links.clear();
+
+    close(listenSocket);
+    if (path[0] != '@') {
+        unlink(path.c_str());
+    }
+}
+
+void SimulationHost::setupEventHandlers() {
+    // 플레이어 상태 변경은 그 플레이어의 게이트웨이로
+    eventBus.subscribe("game_state_changed", [this](const Event& event) {
+        sendFrame(event.data["player_id"].intValue, SimpleMessagePack::pack(event.data));
+    });
+
+    // 전체 상태는 단독 실행과 같은 형식으로 한 번 인코딩해 모든 게이트웨이에 브로드캐스트
+    eventBus.subscribe("game_state_updated", [this](const Event& event) {
+        MessageData enhancedState = event.data;
+        enhancedState["type"] = "game_state_update";
+        broadcastFrame(SimpleMessagePack::pack(enhancedState));
+    });
+}
+
+void SimulationHost::run() {
+    while (running) {
+        int socket = accept4(listenSocket, nullptr, nullptr, SOCK_CLOEXEC);
+        if (socket < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            if (running) {
+                std::cerr << "게이트웨이 연결 수락 실패: " << strerror(errno) << std::endl;
+            }
+            break;
+        }
+        acceptGateway(socket);
+    }
+}
+
+void SimulationHost::stop() {
+    // 블로킹 accept를 깨움
+    if (running.exchange(false)) {
+        shutdown(listenSocket, SHUT_RDWR);
+    }
+}
+
+void SimulationHost::acceptGateway(int socket) {
+    auto link = std::make_unique<ProcessLink>(
+        socket, SimulationProtocol::MAX_RECORD_SIZE, SimulationProtocol::MAX_QUEUED_BYTES);
+    ProcessLink* started = link.get();
+
+    int gateway;
+    std::vector<std::unique_ptr<ProcessLink>> closedLinks;
+    {
+        std::lock_guard<std::mutex> lock(gatewayMutex);
+        gateway = nextGatewayId++;
+        gateways[gateway] = std::move(link);
+
+        // 이전에 끊긴 게이트웨이 링크는 여기서 정리
+        for (auto it = gateways.begin(); it != gateways.end();) {
+            if (!it->second->isOpen()) {
+                closedLinks.push_back(std::move(it->second));
+                it = gateways.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    closedLinks.clear();
+
+    started->start(
+        [this, gateway](const char* data, size_t length) {
+            handleRecord(gateway, data, length);
+        },
+        [this, gateway]() {
+            handleGatewayClosed(gateway);
+        });
+    std::cout << "게이트웨이 " << gateway << " 연결" << std::endl;
+}
+
+void SimulationHost::handleRecord(int gateway, const char* data, size_t length) {
+    std::string name;
+    MessageData eventData;
+    if (SimulationProtocol::recordType(data, length) != SimulationProtocol::EVENT_RECORD ||
+        !SimulationProtocol::decodeEvent(data, length, name, eventData)) {
+        std::cerr << "게이트웨이 " << gateway << "에서 알 수 없는 레코드 수신 (" << length << " 바이트)" << std::endl;
+        return;
+    }
+
+    // 플레이어가 어느 게이트웨이에 연결되어 있는지 기록 (상태 프레임을 돌려보낼 곳)
+    if (eventData.contains("player_id")) {
+        int playerId = eventData["player_id"].intValue;
+        std::lock_guard<std::mutex> lock(gatewayMutex);
+        if (name == "client_disconnected") {
+            playerGateways.erase(playerId);
+        } else {
+            playerGateways[playerId] = gateway;
+        }
+    }
+
+    eventBus.publish(name, eventData);
+}
+
+void SimulationHost::handleGatewayClosed(int gateway) {
+    std::vector<int> players;
+    {
+        std::lock_guard<std::mutex> lock(gatewayMutex);
+        for (auto it = playerGateways.begin(); it != playerGateways.end();) {
+            if (it->second == gateway) {
+                players.push_back(it->first);
+                it = playerGateways.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    std::cerr << "게이트웨이 " << gateway << " 연결 끊김, 플레이어 " << players.size() << "명 제거" << std::endl;
+    for (int playerId : players) {
+        eventBus.publish("client_disconnected", {{"player_id", playerId}});
+    }
+}
+
+void SimulationHost::sendFrame(int playerId, const std::string& frame) {
+    std::lock_guard<std::mutex> lock(gatewayMutex);
+    auto player = playerGateways.find(playerId);
+    if (player == playerGateways.end()) {
+        return;
+    }
+    auto gateway = gateways.find(player->second);
+    if (gateway != gateways.end()) {
+        gateway->second->send(SimulationProtocol::encodeFrame(playerId, frame));
+    }
+}
+
+void SimulationHost::broadcastFrame(const std::string& frame) {
+    std::string record = SimulationProtocol::encodeFrame(SimulationProtocol::BROADCAST, frame);
+    std::lock_guard<std::mutex> lock(gatewayMutex);
+    for (auto& [id, link] : gateways) {
+        link->send(record);
+    }
+}
@@ -1,12 +1,28 @@
 #include "TetrisServer.hpp"
+#include <csignal>
 #include <iostream>
+#include <string.h>
 
-TetrisServer::TetrisServer(int port) : 
+TetrisServer::TetrisServer(const ServerConfig& config) : 
     eventBus(GlobalEventBus::getInstance()),
     playerInfo(eventBus),
-    gameManager(eventBus),
-    networkManager(port, eventBus)
+    drainTimeoutMs(config.drainTimeoutMs),
+    resultsPath(config.resultsPath)
 {
+    if (config.role != ServerConfig::Role::Gateway) {
+        gameManager = std::make_unique<GameManager>(eventBus);
+    }
+    if (config.role != ServerConfig::Role::Simulation) {
+        networkManager = std::make_unique<NetworkManager>(config, eventBus);
+    }
+
+    // 브리지는 아래 연결 처리 핸들러보다 먼저 구독해야 client_connected가 다른 이벤트보다 먼저 넘어감
+    if (config.role == ServerConfig::Role::Gateway) {
+        gatewayBridge = std::make_unique<GatewayBridge>(config, eventBus, *networkManager);
+    } else if (config.role == ServerConfig::Role::Simulation) {
+        simulationHost = std::make_unique<SimulationHost>(config, eventBus);
+    }
+
     setupEventHandlers();
 }
 
@@ -15,24 +31,93 @@ void TetrisServer::setupEventHandlers() {
     eventBus.subscribe("client_connected", [this](const Event& event) {
         this->handleClientConnected(event);
     });
+
+    // 종료 직전 (드레인이 끝나 입력을 더 받지 않을 때, 또는 리액터가 멈춘 뒤) 결과를 한 번 기록
+    eventBus.subscribe("server_shutdown", [this](const Event&) {
+        if (!resultsSaved) {
+            resultsSaved = true;
+            saveResults();
+        }
+    });
 }
 
-void TetrisServer::run() {
+bool TetrisServer::run() {
+    // 종료 신호는 이 스레드에서만 받아 드레인/종료로 바꿈 (main에서 다른 스레드는 막아 둠)
+    signalThread = std::thread([this]() {
+        waitForSignals();
+    });
+
+    bool succeeded = true;
     try {
         std::cout << "테트리스 서버가 시작되었습니다." << std::endl;
         
         // 서버 시작 이벤트 발행
         eventBus.publish("server_started");
         
-        while (true) {
-            networkManager.acceptClient();
+        if (simulationHost) {
+            // 게임 입력은 게이트웨이 링크 스레드가 이벤트로 넘겨줌
+            simulationHost->run();
+        } else {
+            // 이벤트 루프가 연결 수락과 클라이언트 메시지를 모두 처리
+            networkManager->run();
         }
     }
     catch (const std::exception& e) {
         std::cerr << "서버 오류: " << e.what() << std::endl;
+        succeeded = false;
         // 서버 오류 이벤트 발행
         eventBus.publish("server_error", {{"error", e.what()}});
     }
+
+    // 후임 프로세스에 넘긴 게임이나 넘겨받다 그만둔 게임은 다른 프로세스에서 계속되므로 결과를 기록하지 않음
+    if (!networkManager || (!networkManager->handedOffToSuccessor() && !networkManager->takeoverAbandoned())) {
+        eventBus.publish("server_shutdown");
+    }
+
+    finished = true;
+    pthread_kill(signalThread.native_handle(), SIGTERM);
+    signalThread.join();
+    return succeeded;
+}
+
+void TetrisServer::waitForSignals() {
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+
+    int received = 0;
+    while (true) {
+        int signal = 0;
+        if (sigwait(&signals, &signal) != 0) {
+            continue;
+        }
+        if (finished) {
+            break;
+        }
+
+        // 첫 신호: 새 연결을 받지 않고 진행 중인 게임이 끝나기를 기다림. 두 번째 신호: 바로 종료
+        if (received++ == 0 && networkManager) {
+            std::cout << "종료 신호(" << strsignal(signal) << ") 수신: 드레인 시작 (한 번 더 보내면 바로 종료)"
+                      << std::endl;
+            networkManager->drain(drainTimeoutMs);
+            continue;
+        }
+        std::cout << "종료 신호(" << strsignal(signal) << ") 수신: 바로 종료" << std::endl;
+        if (networkManager) {
+            networkManager->stop();
+        }
+        if (simulationHost) {
+            simulationHost->stop();
+        }
+    }
+}
+
+void TetrisServer::saveResults() {
+    // 게이트웨이는 게임 상태가 없음 (시뮬레이션 프로세스가 기록)
+    if (gameManager && !resultsPath.empty()) {
+        gameManager->saveResults(resultsPath);
+    }
 }
 
 void TetrisServer::handleClientConnected(const Event& event) {
@@ -44,8 +129,10 @@ void TetrisServer::handleClientConnected(const Event& event) {
     // PlayerInfo에 플레이어 추가
     playerInfo.addPlayer(playerId, socket);
     
-    // GameManager에 플레이어 추가
-    gameManager.addPlayer(playerId, socket);
+    // GameManager에 플레이어 추가 (게이트웨이에서는 시뮬레이션 프로세스가 처리)
+    if (gameManager) {
+        gameManager->addPlayer(playerId, socket);
+    }
     
     std::cout << "TetrisServer: 플레이어 추가 완료 (ID: " << playerId << ")" << std::endl;
 } 
\ No newline at end of file
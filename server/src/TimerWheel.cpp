@@ -0,0 +1,126 @@
+#include "TimerWheel.hpp"
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+#include <stdexcept>
+#include <string>
+
+TimerWheel::TimerWheel(EventLoop& loop, int tick, size_t slotCount) :
+    eventLoop(loop),
+    tickMs(tick),
+    currentTick(0),
+    activeTimers(0) {
+    size_t size = 1;
+    while (size < slotCount) {
+        size <<= 1;
+    }
+    mask = size - 1;
+    slots = std::vector<Timer>(size);
+    for (auto& head : slots) {
+        head.prev = &head;
+        head.next = &head;
+    }
+
+    timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timerFd < 0) {
+        throw std::runtime_error("timerfd 생성 실패: " + std::string(strerror(errno)));
+    }
+
+    eventLoop.addFd(timerFd, EPOLLIN, [this](uint32_t) {
+        uint64_t expirations = 0;
+        if (read(timerFd, &expirations, sizeof(expirations)) != sizeof(expirations)) {
+            return;
+        }
+        // 루프가 밀려 여러 틱이 지났으면 빠진 틱도 순서대로 처리
+        for (uint64_t i = 0; i < expirations && activeTimers > 0; ++i) {
+            advance();
+        }
+    });
+}
+
+TimerWheel::~TimerWheel() {
+    eventLoop.removeFd(timerFd);
+    close(timerFd);
+}
+
+void TimerWheel::schedule(Timer& timer, uint64_t delayTicks) {
+    if (timer.scheduled()) {
+        unlink(timer);
+    } else if (activeTimers++ == 0) {
+        setArmed(true);
+    }
+
+    timer.expiryTick = currentTick + (delayTicks > 0 ? delayTicks : 1);
+    link(timer);
+}
+
+void TimerWheel::cancel(Timer& timer) {
+    if (!timer.scheduled()) {
+        return;
+    }
+    unlink(timer);
+    if (--activeTimers == 0) {
+        setArmed(false);
+    }
+}
+
+void TimerWheel::link(Timer& timer) {
+    Timer& head = slots[timer.expiryTick & mask];
+    timer.prev = head.prev;
+    timer.next = &head;
+    head.prev->next = &timer;
+    head.prev = &timer;
+}
+
+void TimerWheel::unlink(Timer& timer) {
+    timer.prev->next = timer.next;
+    timer.next->prev = timer.prev;
+    timer.prev = nullptr;
+    timer.next = nullptr;
+}
+
+void TimerWheel::setArmed(bool armed) {
+    itimerspec spec{};
+    if (armed) {
+        spec.it_interval.tv_sec = tickMs / 1000;
+        spec.it_interval.tv_nsec = (tickMs % 1000) * 1000000L;
+        spec.it_value = spec.it_interval;
+    }
+    timerfd_settime(timerFd, 0, &spec, nullptr);
+}
+
+void TimerWheel::advance() {
+    currentTick++;
+
+    // 현재 슬롯을 통째로 떼어 낸 뒤 처리 (콜백이 타이머를 다시 등록하거나 취소해도 안전)
+    Timer& head = slots[currentTick & mask];
+    if (head.next == &head) {
+        return;
+    }
+
+    Timer pending;
+    pending.next = head.next;
+    pending.prev = head.prev;
+    pending.next->prev = &pending;
+    pending.prev->next = &pending;
+    head.next = &head;
+    head.prev = &head;
+
+    while (pending.next != &pending) {
+        Timer& timer = *pending.next;
+        unlink(timer);
+
+        // 휠을 한 바퀴 이상 돌아야 하는 타이머는 같은 슬롯에 다시 넣음
+        if (timer.expiryTick > currentTick) {
+            link(timer);
+            continue;
+        }
+
+        if (--activeTimers == 0) {
+            setArmed(false);
+        }
+        timer.onExpire();
+    }
+}
@@ -0,0 +1,276 @@
+#include "UdpInputChannel.hpp"
+#include "SecureRandom.hpp"
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+uint64_t readBigEndian(const char* data, size_t bytes) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < bytes; ++i) {
+        value = (value << 8) | static_cast<unsigned char>(data[i]);
+    }
+    return value;
+}
+
+void writeBigEndian(char* out, uint64_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; ++i) {
+        out[bytes - 1 - i] = static_cast<char>(value & 0xFF);
+        value >>= 8;
+    }
+}
+
+// 시퀀스 번호가 한 바퀴 돌아도 비교가 유지되도록 차이의 부호로 판단
+bool isNewer(uint32_t sequence, uint32_t than) {
+    return static_cast<int32_t>(sequence - than) > 0;
+}
+
+}  // namespace
+
+UdpInputChannel::UdpInputChannel(int udpPort, EventLoop& loop, EventBus& bus, Decoder decoder,
+                                 const std::atomic<bool>& stopping, double rate, double burst) :
+    port(udpPort),
+    eventLoop(loop),
+    eventBus(bus),
+    decode(std::move(decoder)),
+    shuttingDown(stopping),
+    inputRate(rate),
+    inputBurst(burst),
+    droppedInputs(0) {
+    udpSocket = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (udpSocket < 0) {
+        throw std::runtime_error("UDP 소켓 생성 실패: " + std::string(strerror(errno)));
+    }
+
+    int opt = 1;
+    setsockopt(udpSocket, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = INADDR_ANY;
+    addr.sin_port = htons(port);
+
+    if (::bind(udpSocket, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        close(udpSocket);
+        throw std::runtime_error("UDP 바인드 실패: " + std::string(strerror(errno)));
+    }
+
+    eventLoop.addFd(udpSocket, EPOLLIN | EPOLLET, [this](uint32_t) {
+        receiveDatagrams();
+    });
+
+    std::cout << "UDP 입력 채널 시작: 포트 " << port << std::endl;
+}
+
+UdpInputChannel::~UdpInputChannel() {
+    eventLoop.removeFd(udpSocket);
+    close(udpSocket);
+}
+
+int64_t UdpInputChannel::issueToken(int playerId) {
+    std::lock_guard<std::mutex> lock(sessionMutex);
+
+    auto existing = playerTokens.find(playerId);
+    if (existing != playerTokens.end()) {
+        return existing->second;
+    }
+
+    // 데이터그램에는 토큰 말고 인증 수단이 없으므로 추측할 수 없는 값으로, 이미 쓰는 토큰과 겹치면 다시 뽑음
+    int64_t token;
+    do {
+        token = SecureRandom::token();
+    } while (sessions.count(token));
+
+    Session session;
+    session.playerId = playerId;
+    sessions[token] = session;
+    playerTokens[playerId] = token;
+    return token;
+}
+
+void UdpInputChannel::revokeToken(int playerId) {
+    std::lock_guard<std::mutex> lock(sessionMutex);
+
+    auto it = playerTokens.find(playerId);
+    if (it == playerTokens.end()) {
+        return;
+    }
+    sessions.erase(it->second);
+    playerTokens.erase(it);
+}
+
+void UdpInputChannel::receiveDatagrams() {
+    // recvmmsg로 데이터그램을 한 번에 여러 개 수신
+    static thread_local std::vector<char> buffers(BATCH_SIZE * MAX_DATAGRAM_SIZE);
+    mmsghdr messages[BATCH_SIZE];
+    iovec spans[BATCH_SIZE];
+    sockaddr_in peers[BATCH_SIZE];
+
+    bool handled = false;
+
+    while (true) {
+        for (int i = 0; i < BATCH_SIZE; ++i) {
+            spans[i].iov_base = buffers.data() + i * MAX_DATAGRAM_SIZE;
+            spans[i].iov_len = MAX_DATAGRAM_SIZE;
+            messages[i] = mmsghdr{};
+            messages[i].msg_hdr.msg_iov = &spans[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+            messages[i].msg_hdr.msg_name = &peers[i];
+            messages[i].msg_hdr.msg_namelen = sizeof(peers[i]);
+        }
+
+        int received = recvmmsg(udpSocket, messages, BATCH_SIZE, MSG_DONTWAIT, nullptr);
+        if (received < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                std::cerr << "UDP 수신 오류: " << strerror(errno) << std::endl;
+            }
+            break;
+        }
+
+        for (int i = 0; i < received; ++i) {
+            // 잘린 데이터그램은 정상적인 입력 패킷이 아니므로 버림
+            if (messages[i].msg_hdr.msg_flags & MSG_TRUNC) {
+                continue;
+            }
+            handleDatagram(static_cast<const char*>(spans[i].iov_base), messages[i].msg_len, peers[i]);
+            handled = true;
+        }
+
+        // 배치를 다 채우지 못했으면 소켓 큐가 비어 있음
+        if (received < BATCH_SIZE) {
+            break;
+        }
+    }
+
+    // 수신한 입력 묶음의 처리가 끝났음을 알림 (게임 상태 변경을 모아서 전송)
+    if (handled) {
+        eventBus.publish("client_messages_processed", {});
+    }
+}
+
+void UdpInputChannel::handleDatagram(const char* data, size_t length, const sockaddr_in& from) {
+    // 종료 처리(결과 기록) 뒤에는 게임 상태를 바꾸지 않음. ack도 보내지 않아 시퀀스를 진행시키지 않음
+    if (length < HEADER_SIZE || shuttingDown) {
+        return;
+    }
+
+    int64_t token = static_cast<int64_t>(readBigEndian(data, 8));
+    size_t count = static_cast<unsigned char>(data[8]);
+
+    struct Input {
+        uint32_t sequence;
+        const char* body;
+        size_t length;
+    };
+    Input inputs[255];
+    size_t inputCount = 0;
+
+    size_t offset = HEADER_SIZE;
+    for (size_t i = 0; i < count; ++i) {
+        if (offset + INPUT_HEADER_SIZE > length) {
+            return;
+        }
+        uint32_t sequence = static_cast<uint32_t>(readBigEndian(data + offset, 4));
+        size_t bodyLength = readBigEndian(data + offset + 4, 2);
+        offset += INPUT_HEADER_SIZE;
+        if (offset + bodyLength > length) {
+            return;
+        }
+        inputs[inputCount++] = Input{sequence, data + offset, bodyLength};
+        offset += bodyLength;
+    }
+
+    int playerId;
+    uint32_t ackSequence;
+    {
+        std::lock_guard<std::mutex> lock(sessionMutex);
+
+        // 토큰이 없는 데이터그램은 인증되지 않은 것으로 보고 조용히 버림
+        auto it = sessions.find(token);
+        if (it == sessions.end()) {
+            return;
+        }
+        Session& session = it->second;
+        playerId = session.playerId;
+        session.peer = from;
+
+        // 이미 처리한 입력(중복 전송분)을 제거하고 시퀀스 순서로 정렬
+        Input* end = std::remove_if(inputs, inputs + inputCount, [&session](const Input& input) {
+            return !isNewer(input.sequence, session.lastSequence);
+        });
+        std::sort(inputs, end, [](const Input& a, const Input& b) {
+            return isNewer(b.sequence, a.sequence);
+        });
+        end = std::unique(inputs, end, [](const Input& a, const Input& b) {
+            return a.sequence == b.sequence;
+        });
+        inputCount = end - inputs;
+
+        if (inputCount > 0) {
+            session.lastSequence = inputs[inputCount - 1].sequence;
+        }
+        ackSequence = session.lastSequence;
+
+        // 속도 제한을 넘는 새 입력은 버림 (재전송되지 않도록 ack에는 포함)
+        if (inputRate > 0 && inputCount > 0) {
+            timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            int64_t nowNs = now.tv_sec * 1000000000LL + now.tv_nsec;
+
+            size_t accepted = 0;
+            for (size_t i = 0; i < inputCount; ++i) {
+                if (session.inputBucket.take(inputRate, inputBurst, nowNs)) {
+                    inputs[accepted++] = inputs[i];
+                }
+            }
+            if (accepted < inputCount) {
+                if (session.droppedInputs == 0) {
+                    std::cerr << "UDP 플레이어 " << playerId << " 입력 속도 제한 초과, 초과 입력을 버림" << std::endl;
+                }
+                session.droppedInputs += inputCount - accepted;
+                droppedInputs += inputCount - accepted;
+            }
+            inputCount = accepted;
+        }
+    }
+
+    // 이벤트 발행은 세션 잠금 밖에서 (토큰 발급이 이벤트 처리 중에 일어나므로)
+    for (size_t i = 0; i < inputCount; ++i) {
+        try {
+            MessageData msg = decode(inputs[i].body, inputs[i].length);
+            if (!msg.contains("type") || msg["type"].stringValue == "connect") {
+                continue;
+            }
+            msg["player_id"] = playerId;
+            eventBus.publish("client_message_received", msg);
+        }
+        catch (const std::exception& e) {
+            std::cerr << "UDP 입력 파싱 오류 (플레이어 " << playerId << "): " << e.what() << std::endl;
+        }
+    }
+
+    sendAck(token, ackSequence, from);
+}
+
+void UdpInputChannel::sendAck(int64_t token, uint32_t sequence, const sockaddr_in& peer) {
+    char ack[ACK_SIZE];
+    writeBigEndian(ack, static_cast<uint64_t>(token), 8);
+    writeBigEndian(ack + 8, sequence, 4);
+
+    // ack가 유실되면 클라이언트가 입력을 다시 실어 보내므로 전송 실패는 무시
+    ssize_t sent = sendto(udpSocket, ack, sizeof(ack), MSG_DONTWAIT,
+                          (const struct sockaddr*)&peer, sizeof(peer));
+    (void)sent;
+}
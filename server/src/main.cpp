@@ -1,15 +1,155 @@
 #include "TetrisServer.hpp"
+#include "ServerConfig.hpp"
+#include "PlayerIdAllocator.hpp"
+#include <csignal>
+#include <cstdlib>
 #include <iostream>
+#include <string>
+#include <vector>
+
+// 쉼표로 구분한 목록 (빈 항목은 무시)
+static std::vector<std::string> splitList(const std::string& text) {
+    std::vector<std::string> items;
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t end = text.find(',', start);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        if (end > start) {
+            items.push_back(text.substr(start, end - start));
+        }
+        start = end + 1;
+    }
+    return items;
+}
 
 int main(int argc, char* argv[]) {
     try {
-        int port = 12345;  // 기본 포트
-        if (argc > 1) {
-            port = std::atoi(argv[1]);
+        ServerConfig config;  // 기본 포트 12345, epoll 백엔드
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--backend=epoll") {
+                config.backend = ServerConfig::Backend::Epoll;
+            } else if (arg == "--backend=io_uring") {
+                config.backend = ServerConfig::Backend::IoUring;
+            } else if (arg.rfind("--gateway=", 0) == 0) {
+                config.role = ServerConfig::Role::Gateway;
+                config.simulationPaths = splitList(arg.substr(10));
+            } else if (arg.rfind("--simulation=", 0) == 0) {
+                config.role = ServerConfig::Role::Simulation;
+                config.simulationPaths = {arg.substr(13)};
+            } else if (arg.rfind("--nodes=", 0) == 0) {
+                config.nodes = splitList(arg.substr(8));
+            } else if (arg.rfind("--node-index=", 0) == 0) {
+                config.nodeIndex = std::atoi(arg.c_str() + 13);
+            } else if (arg.rfind("--handoff=", 0) == 0) {
+                config.handoffPath = arg.substr(10);
+            } else if (arg.rfind("--takeover=", 0) == 0) {
+                config.takeoverPath = arg.substr(11);
+            } else if (arg.rfind("--gateway-id=", 0) == 0) {
+                config.gatewayId = std::atoi(arg.c_str() + 13);
+            } else if (arg.rfind("--reactors=", 0) == 0) {
+                config.reactorCount = std::atoi(arg.c_str() + 11);
+            } else if (arg.rfind("--udp-port=", 0) == 0) {
+                config.udpPort = std::atoi(arg.c_str() + 11);
+            } else if (arg.rfind("--unix=", 0) == 0) {
+                config.unixPath = arg.substr(7);
+            } else if (arg == "--unix-seqpacket") {
+                config.unixSeqPacket = true;
+            } else if (arg.rfind("--shm-ring=", 0) == 0) {
+                config.sharedRingSize = std::strtoul(arg.c_str() + 11, nullptr, 10);
+            } else if (arg.rfind("--busy-poll-port=", 0) == 0) {
+                config.busyPollPort = std::atoi(arg.c_str() + 17);
+            } else if (arg == "--unix-busy-poll") {
+                config.unixBusyPoll = true;
+            } else if (arg.rfind("--busy-poll-us=", 0) == 0) {
+                config.busyPollUs = std::atoi(arg.c_str() + 15);
+            } else if (arg.rfind("--busy-poll-budget=", 0) == 0) {
+                config.busyPollBudget = std::atoi(arg.c_str() + 19);
+            } else if (arg.rfind("--busy-spin-us=", 0) == 0) {
+                config.busySpinUs = std::atoi(arg.c_str() + 15);
+            } else if (arg.rfind("--max-connections=", 0) == 0) {
+                config.maxConnections = std::atoi(arg.c_str() + 18);
+            } else if (arg.rfind("--max-handshakes=", 0) == 0) {
+                config.maxPendingHandshakes = std::atoi(arg.c_str() + 17);
+            } else if (arg.rfind("--max-congested=", 0) == 0) {
+                config.maxCongestedConnections = std::atoi(arg.c_str() + 16);
+            } else if (arg.rfind("--max-reactor-load=", 0) == 0) {
+                config.maxReactorLoad = std::atof(arg.c_str() + 19);
+            } else if (arg.rfind("--max-frame=", 0) == 0) {
+                config.maxFrameSize = std::strtoul(arg.c_str() + 12, nullptr, 10);
+            } else if (arg == "--zerocopy") {
+                config.zeroCopyThreshold = 16 * 1024;
+            } else if (arg.rfind("--zerocopy=", 0) == 0) {
+                config.zeroCopyThreshold = std::strtoul(arg.c_str() + 11, nullptr, 10);
+            } else if (arg.rfind("--heartbeat-ms=", 0) == 0) {
+                config.heartbeatIntervalMs = std::atoi(arg.c_str() + 15);
+            } else if (arg.rfind("--idle-timeout-ms=", 0) == 0) {
+                config.idleTimeoutMs = std::atoi(arg.c_str() + 18);
+            } else if (arg.rfind("--rtt-probe-ms=", 0) == 0) {
+                config.rttProbeIntervalMs = std::atoi(arg.c_str() + 15);
+            } else if (arg.rfind("--input-rate=", 0) == 0) {
+                config.inputRate = std::atof(arg.c_str() + 13);
+            } else if (arg.rfind("--input-burst=", 0) == 0) {
+                config.inputBurst = std::atof(arg.c_str() + 14);
+            } else if (arg.rfind("--local-input-rate=", 0) == 0) {
+                config.localInputRate = std::atof(arg.c_str() + 19);
+            } else if (arg.rfind("--local-input-burst=", 0) == 0) {
+                config.localInputBurst = std::atof(arg.c_str() + 20);
+            } else if (arg.rfind("--session-grace-ms=", 0) == 0) {
+                config.sessionGraceMs = std::atoi(arg.c_str() + 19);
+            } else if (arg.rfind("--drain-timeout-ms=", 0) == 0) {
+                config.drainTimeoutMs = std::atoi(arg.c_str() + 19);
+            } else if (arg.rfind("--results=", 0) == 0) {
+                config.resultsPath = arg.substr(10);
+            } else if (arg == "--verbose") {
+                config.verboseLog = true;
+            } else if (arg.rfind("--", 0) == 0) {
+                std::cerr << "알 수 없는 옵션: " << arg << std::endl;
+                std::cerr << "사용법: " << argv[0] << " [포트] [--backend=epoll|io_uring] [--reactors=N] [--udp-port=N]" << std::endl;
+                std::cerr << "       [--gateway=시뮬레이션소켓[,...]] [--gateway-id=N] [--simulation=소켓]" << std::endl;
+                std::cerr << "       [--nodes=호스트:포트,... --node-index=N] [--handoff=소켓] [--takeover=소켓]" << std::endl;
+                std::cerr << "       [--unix=경로|@추상이름] [--unix-seqpacket] [--unix-busy-poll] [--shm-ring=바이트]" << std::endl;
+                std::cerr << "       [--busy-poll-port=N] [--busy-poll-us=N] [--busy-poll-budget=N] [--busy-spin-us=N]" << std::endl;
+                std::cerr << "       [--max-connections=N] [--max-handshakes=N] [--max-congested=N] [--max-reactor-load=0~1]" << std::endl;
+                std::cerr << "       [--heartbeat-ms=N] [--idle-timeout-ms=N] [--rtt-probe-ms=N] [--zerocopy[=바이트]] [--max-frame=바이트]" << std::endl;
+                std::cerr << "       [--session-grace-ms=N] [--input-rate=초당개수] [--input-burst=N]" << std::endl;
+                std::cerr << "       [--local-input-rate=초당개수] [--local-input-burst=N]" << std::endl;
+                std::cerr << "       [--drain-timeout-ms=N] [--results=파일] [--verbose]" << std::endl;
+                return 1;
+            } else {
+                config.port = std::atoi(arg.c_str());
+            }
         }
         
-        TetrisServer server(port);
-        server.run();
+        if (config.role == ServerConfig::Role::Gateway && config.simulationPaths.empty()) {
+            std::cerr << "--gateway에 시뮬레이션 소켓 경로가 필요합니다." << std::endl;
+            return 1;
+        }
+        if (config.gatewayId < 0 || config.gatewayId >= PlayerIdAllocator::MAX_GATEWAYS) {
+            std::cerr << "--gateway-id는 0~" << PlayerIdAllocator::MAX_GATEWAYS - 1 << " 범위여야 합니다." << std::endl;
+            return 1;
+        }
+        
+        if ((!config.handoffPath.empty() || !config.takeoverPath.empty()) &&
+            (config.role != ServerConfig::Role::Standalone || config.backend != ServerConfig::Backend::Epoll ||
+             config.udpPort > 0)) {
+            std::cerr << "--handoff/--takeover는 단독 실행, epoll 백엔드, UDP 입력 채널 없이만 사용할 수 있습니다." << std::endl;
+            return 1;
+        }
+        
+        // 종료 신호는 서버의 신호 대기 스레드만 받도록 다른 스레드를 만들기 전에 막아 둠 (모든 스레드가 물려받음)
+        sigset_t signals;
+        sigemptyset(&signals);
+        sigaddset(&signals, SIGINT);
+        sigaddset(&signals, SIGTERM);
+        pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+        
+        TetrisServer server(config);
+        if (!server.run()) {
+            return 1;
+        }
         
     } catch (const std::exception& e) {
         std::cerr << "오류: " << e.what() << std::endl;
@@ -17,4 +157,4 @@ int main(int argc, char* argv[]) {
     }
     
     return 0;
-} 
\ No newline at end of file
+}
@@ -0,0 +1,132 @@
+"""통합 테스트 공용: 서버 실행과 프레임 송수신
+
+클라이언트 → 서버는 표준 MessagePack, 서버 → 클라이언트는 SimpleMessagePack 자체 형식이며
+둘 다 4바이트 빅엔디언 길이 접두사로 구분합니다. 외부 패키지 없이 돌도록 필요한 만큼만 구현합니다.
+"""
+import os
+import socket
+import struct
+import subprocess
+import sys
+import tempfile
+import time
+
+
+def pack(value):
+    # 표준 MessagePack (테스트가 보내는 맵/문자열/정수만)
+    if isinstance(value, bool):
+        return b'\xc3' if value else b'\xc2'
+    if isinstance(value, int):
+        return b'\xd3' + struct.pack('>q', value)
+    if isinstance(value, str):
+        data = value.encode()
+        return b'\xdb' + struct.pack('>I', len(data)) + data
+    if isinstance(value, dict):
+        body = b''.join(pack(k) + pack(v) for k, v in value.items())
+        return b'\xdf' + struct.pack('>I', len(value)) + body
+    raise TypeError(value)
+
+
+def frame(message):
+    body = pack(message)
+    return struct.pack('>I', len(body)) + body
+
+
+def _unpack(data, i):
+    # SimpleMessagePack 형식: 타입 1바이트 + 리틀엔디언 값
+    kind = data[i]
+    i += 1
+    if kind == 0:
+        return None, i
+    if kind == 1:
+        return bool(data[i]), i + 1
+    if kind == 2:
+        return struct.unpack_from('<q', data, i)[0], i + 8
+    if kind == 3:
+        return struct.unpack_from('<d', data, i)[0], i + 8
+    if kind == 4:
+        n = struct.unpack_from('<I', data, i)[0]
+        i += 4
+        return data[i:i + n].decode(errors='replace'), i + n
+    if kind == 5:
+        n = struct.unpack_from('<I', data, i)[0]
+        i += 4
+        items = []
+        for _ in range(n):
+            item, i = _unpack(data, i)
+            items.append(item)
+        return items, i
+    if kind == 6:
+        n = struct.unpack_from('<I', data, i)[0]
+        i += 4
+        result = {}
+        for _ in range(n):
+            length = struct.unpack_from('<I', data, i)[0]
+            i += 4
+            key = data[i:i + length].decode()
+            i += length
+            result[key], i = _unpack(data, i)
+        return result, i
+    raise ValueError('알 수 없는 타입 %d' % kind)
+
+
+def receive(sock, timeout=0.5):
+    """timeout 동안 들어온 프레임을 모두 읽음 (연결이 끊겨도 그때까지 받은 프레임 반환)"""
+    sock.settimeout(timeout)
+    buffer = b''
+    try:
+        while True:
+            chunk = sock.recv(65536)
+            if not chunk:
+                break
+            buffer += chunk
+    except socket.timeout:
+        pass
+    except ConnectionResetError:
+        pass
+    frames = []
+    while len(buffer) >= 4:
+        size = struct.unpack('>I', buffer[:4])[0]
+        if len(buffer) < 4 + size:
+            break
+        frames.append(_unpack(buffer[4:4 + size], 0)[0])
+        buffer = buffer[4 + size:]
+    return frames
+
+
+def free_port():
+    with socket.socket() as probe:
+        probe.bind(('127.0.0.1', 0))
+        return probe.getsockname()[1]
+
+
+def start_server(executable, args, log_name):
+    log = open(os.path.join(tempfile.gettempdir(), log_name), 'w')
+    return subprocess.Popen([executable] + args, stdout=log, stderr=subprocess.STDOUT)
+
+
+def wait_port(port, timeout=5.0):
+    deadline = time.time() + timeout
+    while time.time() < deadline:
+        try:
+            socket.create_connection(('127.0.0.1', port), timeout=0.2).close()
+            return
+        except OSError:
+            time.sleep(0.05)
+    raise RuntimeError('서버가 포트 %d에서 응답하지 않음' % port)
+
+
+def connect(port, nickname='test'):
+    sock = socket.create_connection(('127.0.0.1', port))
+    sock.sendall(frame({'type': 'connect', 'nickname': nickname}))
+    frames = receive(sock)
+    responses = [f for f in frames if f.get('type') == 'connect_response']
+    if not responses:
+        raise RuntimeError('connect_response 없음: %r' % frames)
+    return sock, responses[0]['player_id'], frames
+
+
+def check(condition, message):
+    if not condition:
+        print('실패: ' + message)
+        sys.exit(1)
@@ -0,0 +1,121 @@
+"""무중단 재시작 중 후임 프로세스의 ACK가 늦어도 한 프로세스만 소켓을 서비스해야 함
+
+이전 프로세스(--handoff)와 후임 프로세스(--takeover) 사이에 중계 소켓을 두고 주고받는 내용을 그대로 넘기되,
+후임의 ACK를 이전 프로세스의 제한 시간이 지날 때까지 붙잡아 둡니다.
+  - 이전 프로세스는 제한 시간이 지나면 서비스를 재개
+  - 후임 프로세스는 확정 ACK를 받지 못하므로 넘겨받은 fd를 닫고 실패로 종료
+ACK를 바로 넘기면 후임이 서비스를 이어받고 이전 프로세스는 정상 종료해야 합니다.
+
+사용법: test_hot_restart_ack.py <TetrisServer 실행 파일>
+"""
+import os
+import shutil
+import socket
+import struct
+import sys
+import tempfile
+import time
+
+from server_protocol import check, connect, frame, free_port, receive, start_server, wait_port
+
+ACK_TIMEOUT = 10.0  # HotRestart::ACK_TIMEOUT_MS
+MAX_FDS_PER_MESSAGE = 250
+
+
+def read_exact(sock, size):
+    data = b''
+    while len(data) < size:
+        chunk = sock.recv(size - len(data))
+        if not chunk:
+            raise RuntimeError('중계 중 연결이 끊김')
+        data += chunk
+    return data
+
+
+def relay_state(source, target):
+    # [상태 길이][상태][fd 개수] 다음 fd 묶음마다 1바이트 메시지 (fd는 메시지 경계를 지켜 옮겨야 함)
+    header = read_exact(source, 4)
+    body = read_exact(source, struct.unpack('>I', header)[0])
+    count_bytes = read_exact(source, 4)
+    target.sendall(header + body + count_bytes)
+    remaining = struct.unpack('>I', count_bytes)[0]
+    while remaining > 0:
+        marker, fds, _, _ = socket.recv_fds(source, 1, MAX_FDS_PER_MESSAGE)
+        socket.send_fds(target, [marker], fds)
+        for fd in fds:
+            os.close(fd)
+        remaining -= len(fds)
+
+
+def accept_relay(listener, handoff_path):
+    successor, _ = listener.accept()
+    predecessor = socket.socket(socket.AF_UNIX)
+    predecessor.connect(handoff_path)
+    relay_state(predecessor, successor)
+    return predecessor, successor
+
+
+def moved(sock, player_id):
+    sock.sendall(frame({'type': 'move_left'}))
+    return [f for f in receive(sock) if f.get('type') == 'player_state' and f.get('player_id') == player_id]
+
+
+def main():
+    executable = sys.argv[1]
+    directory = tempfile.mkdtemp()
+    handoff_path = os.path.join(directory, 'handoff.sock')
+    relay_path = os.path.join(directory, 'relay.sock')
+    port = free_port()
+    listener = socket.socket(socket.AF_UNIX)
+    listener.bind(relay_path)
+    listener.listen(1)
+
+    processes = []
+    try:
+        first = start_server(executable, [str(port), '--handoff=' + handoff_path], 'test_hot_restart_first.log')
+        processes.append(first)
+        wait_port(port)
+        sock, player_id, _ = connect(port)
+
+        # 1. ACK를 붙잡아 이전 프로세스가 제한 시간을 넘기게 함
+        stalled = start_server(executable, [str(port), '--takeover=' + relay_path], 'test_hot_restart_stalled.log')
+        processes.append(stalled)
+        predecessor, successor = accept_relay(listener, handoff_path)
+        check(read_exact(successor, 1) == b'K', '후임 프로세스가 ACK를 보내지 않음')
+        time.sleep(ACK_TIMEOUT + 0.5)
+        check(predecessor.recv(1) == b'', '제한 시간이 지났는데 이전 프로세스가 확정 ACK를 보냄')
+        predecessor.close()
+        successor.close()
+
+        code = stalled.wait(timeout=ACK_TIMEOUT + 5)
+        check(code != 0, '확정받지 못한 후임 프로세스가 정상 종료함 (%d)' % code)
+        check(first.poll() is None, '이전 프로세스가 서비스를 재개하지 않고 종료함')
+        check(len(moved(sock, player_id)) == 1, '이전 프로세스가 기존 연결에 응답하지 않음')
+        other, _, _ = connect(port, 'other')
+        other.close()
+
+        # 2. 그대로 중계하면 후임이 이어받고 이전 프로세스는 정상 종료
+        second = start_server(executable, [str(port), '--takeover=' + relay_path], 'test_hot_restart_second.log')
+        processes.append(second)
+        predecessor, successor = accept_relay(listener, handoff_path)
+        predecessor.sendall(read_exact(successor, 1))
+        successor.sendall(read_exact(predecessor, 1))
+        predecessor.close()
+        successor.close()
+
+        check(first.wait(timeout=5) == 0, '넘겨준 이전 프로세스가 정상 종료하지 않음')
+        check(second.poll() is None, '확정받은 후임 프로세스가 종료함')
+        check(len(moved(sock, player_id)) == 1, '후임 프로세스가 기존 연결에 응답하지 않음')
+        sock.close()
+    finally:
+        for process in processes:
+            if process.poll() is None:
+                process.kill()
+            process.wait()
+        listener.close()
+        shutil.rmtree(directory, ignore_errors=True)
+    print('통과')
+
+
+if __name__ == '__main__':
+    main()
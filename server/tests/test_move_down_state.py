@@ -0,0 +1,48 @@
+"""번호가 붙은 move_down은 위치를 예측하지 않았으면 전체 상태로, 예측이 맞으면 input_ack로만 응답해야 함
+
+사용법: test_move_down_state.py <TetrisServer 실행 파일>
+"""
+import sys
+
+from server_protocol import check, connect, frame, free_port, receive, start_server, wait_port
+
+
+def states(frames, player_id):
+    return [f for f in frames if f.get('type') == 'player_state' and f.get('player_id') == player_id]
+
+
+def main():
+    port = free_port()
+    server = start_server(sys.argv[1], [str(port)], 'test_move_down_state.log')
+    try:
+        wait_port(port)
+        sock, player_id, _ = connect(port)
+
+        # 예측 위치 없이 보내면 새 위치를 담은 상태가 와야 함 (input_ack만 오면 클라이언트가 위치를 모름)
+        sock.sendall(frame({'type': 'move_down', 'seq': 1}))
+        frames = receive(sock)
+        first = states(frames, player_id)
+        check(len(first) == 1, 'seq 1 move_down에 player_state가 없음: %r' % frames)
+        check(first[0]['input_seq'] == 1, 'input_seq가 1이 아님: %r' % first[0])
+        y, x = first[0]['position']
+
+        # 예측한 위치가 결과와 같으면 상태 없이 처리한 입력 번호만 알림
+        sock.sendall(frame({'type': 'move_down', 'seq': 2, 'expect_y': y + 1, 'expect_x': x}))
+        frames = receive(sock)
+        check(not states(frames, player_id), '예측이 맞았는데 player_state를 보냄: %r' % frames)
+        acks = [f for f in frames if f.get('type') == 'input_ack']
+        check(len(acks) == 1 and acks[0]['input_seq'] == 2, 'seq 2 input_ack 없음: %r' % frames)
+
+        # 그 위치를 기준으로 다시 예측 없이 보내면 한 칸 더 내려간 상태
+        sock.sendall(frame({'type': 'move_down', 'seq': 3}))
+        third = states(receive(sock), player_id)
+        check(len(third) == 1 and third[0]['position'] == [y + 2, x], 'seq 3 상태가 잘못됨: %r' % third)
+        sock.close()
+    finally:
+        server.kill()
+        server.wait()
+    print('통과')
+
+
+if __name__ == '__main__':
+    main()
@@ -33,7 +33,7 @@ SHAPES = [
 ]
 
 class TetrisGame:
-    def __init__(self):
+    def __init__(self, room=None):
         pygame.init()
         
         # 게임 설정
@@ -66,10 +66,19 @@ class TetrisGame:
         self.fall_speed = 0.5
         
         # 네트워크 관련 초기화
+        # 방을 지정하면 그 방을 맡은 노드로 안내(redirect)받을 수 있음
+        self.server_address = ('localhost', 12345)
+        self.room = room
+        self.redirect_to = None
+        self.redirect_token = None  # 방이 옮겨 갔으면 새 노드에서 상태를 이어 받을 토큰
         self.socket = None
         self.player_id = None
         self.other_players = {}
         
+        # 클라이언트 예측: 입력마다 번호를 붙여 보내고 서버가 처리했다고 알린 번호까지는 버림
+        self.input_seq = 0
+        self.pending_inputs = []  # (번호, 입력 타입) - 서버 확인 전이라 로컬에서만 적용된 입력
+        
         # 색상 추가
         self.GRID_COLOR = COLORS["WHITE"]
         self.BACKGROUND_COLOR = (40, 40, 40)
@@ -353,18 +362,25 @@ class TetrisGame:
             print(f"메시지 언패킹 오류: {e}")
             raise
 
-    def connect_to_server(self):
+    def connect_to_server(self, session_token=None):
         self.socket = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
         try:
-            print(f"서버({('localhost', 12345)})에 연결 시도 중...")
-            self.socket.connect(('localhost', 12345))
+            print(f"서버({self.server_address})에 연결 시도 중...")
+            self.socket.connect(self.server_address)
             print("서버에 연결됨, 초기 메시지 전송 중...")
             
             # 초기 연결 메시지 전송 - send_message 함수 사용
-            self.send_message({
-                "type": "connect",
-                "nickname": f"Player{random.randint(1000, 9999)}"
-            })
+            if session_token:
+                # 옮겨 간 방: 새 노드가 복원해 둔 플레이어로 이어 받음 (resume_response로 ID가 바뀜)
+                connect_message = {"type": "resume", "session_token": session_token}
+            else:
+                connect_message = {
+                    "type": "connect",
+                    "nickname": f"Player{random.randint(1000, 9999)}"
+                }
+                if self.room:
+                    connect_message["room"] = self.room
+            self.send_message(connect_message)
             
             # 타임아웃 설정 (10초)
             self.socket.settimeout(10)
@@ -397,10 +413,13 @@ class TetrisGame:
                 response = self.unpack_message(message_data)
                 print(f"서버 응답: {response}")
                 
-                # 응답 처리
-                if response.get("type") == "connect_response":
-                    self.player_id = response.get("player_id")
-                    print(f"플레이어 ID 설정됨: {self.player_id}")
+                # 응답 처리 (서버는 connect/resume 메시지를 받은 뒤 플레이어를 만들고 응답함)
+                if response.get("type") in ("connect_response", "resume_response", "redirect"):
+                    self.process_server_message(response)
+                    if self.redirect_to:
+                        # 방을 맡은 노드로 바로 옮겨 감
+                        self.follow_redirect()
+                        return
                     
                     # 타임아웃 제거 및 메시지 수신 스레드 시작
                     self.socket.settimeout(None)
@@ -420,6 +439,21 @@ class TetrisGame:
                 self.socket = None
             raise e
 
+    def follow_redirect(self):
+        print(f"방 {self.room} 소속 노드 {self.redirect_to}로 재연결")
+        self.server_address = self.redirect_to
+        session_token = self.redirect_token
+        self.redirect_to = None
+        self.redirect_token = None
+        self.socket.close()
+        self.player_id = None
+        self.pending_inputs = []
+        try:
+            self.connect_to_server(session_token)
+        except Exception as e:
+            print(f"재연결 실패: {e}")
+            self.game_over = True
+
     def send_to_server(self, data):
         try:
             # send_message 함수 사용
@@ -469,6 +503,11 @@ class TetrisGame:
                     self.process_server_message(parsed_message)
                 except Exception as e:
                     print(f"메시지 파싱 오류: {e}, 데이터 길이: {len(message_data)}")
+                
+                if self.redirect_to:
+                    # 방을 맡은 노드로 다시 연결 (새 수신 스레드가 이어서 처리)
+                    self.follow_redirect()
+                    break
                     
             except socket.error as e:
                 print(f"소켓 오류: {e}")
@@ -504,6 +543,44 @@ class TetrisGame:
                         if str(k) != str(self.player_id)
                     }
                     
+            elif message_type == "input_ack":
+                # 예측한 결과와 서버 결과가 같음: 확인된 입력만 정리
+                self.acknowledge_inputs(data.get("input_seq", 0))
+                
+            elif message_type in ("player_state", "game_state_delta"):
+                # 서버의 보정 상태를 적용한 뒤 아직 처리되지 않은 입력을 다시 예측 적용
+                if "cells" in data:
+                    for y, x, value in data["cells"]:
+                        self.board[y][x] = value
+                else:
+                    self.board = data.get("board", self.board)
+                piece = data.get("current_piece")
+                if piece:
+                    self.current_piece = piece.get("shape", self.current_piece)
+                self.current_pos = data.get("position", self.current_pos)
+                self.score = data.get("score", self.score)
+                self.acknowledge_inputs(data.get("input_seq", 0))
+                for _, input_type in self.pending_inputs:
+                    self.predict_input(input_type)
+                
+            elif message_type == "ping":
+                # 서버 하트비트에 응답 (응답이 없으면 유휴 연결로 정리됨)
+                # 서버 시각을 돌려주고 내 시각을 실어 서버가 RTT와 시계 오차를 잴 수 있게 함
+                pong = {"type": "pong", "client_time": int(time.time() * 1000000)}
+                if "server_time" in data:
+                    pong["server_time"] = data["server_time"]
+                self.send_message(pong)
+                
+            elif message_type == "redirect":
+                # 이 방은 다른 노드 소속: 수신 루프가 현재 메시지 처리를 마친 뒤 옮겨 감
+                self.redirect_to = (data.get("host"), data.get("port"))
+                self.redirect_token = data.get("session_token")
+                
+            elif message_type == "resume_response":
+                if data.get("status") == "success":
+                    self.player_id = data.get("player_id")
+                    print(f"세션 재개, 플레이어 ID: {self.player_id}")
+                
             elif message_type == "game_over":
                 if str(data.get("player_id")) == str(self.player_id):
                     self.game_over = True
@@ -540,19 +617,52 @@ class TetrisGame:
         except Exception as e:
             print(f"메시지 전송 중 오류 발생: {e}")
     
+    def predict_input(self, input_type):
+        """입력을 로컬 상태에 바로 적용하고, 조각이 움직였으면 예상 위치를 반환"""
+        if not self.current_piece or not self.current_pos:
+            return None
+        if input_type in ("move_left", "move_right", "move_down"):
+            dy, dx = {"move_left": (0, -1), "move_right": (0, 1), "move_down": (1, 0)}[input_type]
+            new_pos = [self.current_pos[0] + dy, self.current_pos[1] + dx]
+            if self.valid_move(self.current_piece, new_pos):
+                self.current_pos = new_pos
+                return new_pos
+        elif input_type == "rotate":
+            # 서버와 같은 시계 방향 회전
+            rotated = [list(row) for row in zip(*self.current_piece[::-1])]
+            if self.valid_move(rotated, self.current_pos):
+                self.current_piece = rotated
+                return list(self.current_pos)
+        # 블록 고정/새 조각은 서버만 결정하므로 예측하지 않음
+        return None
+
+    def acknowledge_inputs(self, input_seq):
+        self.pending_inputs = [(seq, t) for seq, t in self.pending_inputs if seq > input_seq]
+
+    def send_input(self, input_type):
+        self.input_seq += 1
+        message = {"type": input_type, "seq": self.input_seq}
+        expected = self.predict_input(input_type)
+        if expected is not None:
+            # 예측이 맞으면 서버는 전체 상태 대신 input_ack만 보냄
+            message["expect_y"], message["expect_x"] = expected
+        self.pending_inputs.append((self.input_seq, input_type))
+        self.send_message(message)
+
     def handle_key_press(self, key):
         if key == pygame.K_LEFT:
-            self.send_message({"type": "move_left"})
+            self.send_input("move_left")
         elif key == pygame.K_RIGHT:
-            self.send_message({"type": "move_right"})
+            self.send_input("move_right")
         elif key == pygame.K_UP:
-            self.send_message({"type": "rotate"})
+            self.send_input("rotate")
         elif key == pygame.K_DOWN:
-            self.send_message({"type": "move_down"})
+            self.send_input("move_down")
         elif key == pygame.K_SPACE:
-            self.send_message({"type": "hard_drop"})
+            self.send_input("hard_drop")
 
 if __name__ == "__main__":
-    game = TetrisGame()
+    # 사용법: python tetris_client.py [방 이름]
+    game = TetrisGame(sys.argv[1] if len(sys.argv) > 1 else None)
     if game.socket and game.player_id:  # 서버 연결이 성공한 경우에만 게임 실행
         game.run() 
\ No newline at end of file